@@ -74,11 +74,29 @@ public:
 
     /*
      * Helper function for get_ith_pointless_ability:
-     * Recursively search the tree for the node that has the given index
+     * Search the subtree of the given node for the node that has the given index
      * @param - The current node and index to be searched for
-     * @return - the requested node
+     * @return - the requested node, or nullptr if the index is out of the subtree's range
+     */
+    ComplexNode<T>* find_index(ComplexNode<T>* node, int index);
+
+    /*
+     * Helper function for get_ith_pointless_abilities:
+     * Find the data of the nodes with all of the given indices in a single descent from the root.
+     * At each node, the indices are split between its left subtree, the node itself and its right subtree,
+     *       so the nodes shared by the paths to several indices are only visited once.
+     * @param - The indices to be searched for (sorted in non-decreasing order), their number and an array
+     *       that receives the data of each index (T() for indices out of range)
+     * @return - void
+     */
+    void find_indices(const int* indices, const int numIndices, T* results);
+
+    /*
+     * Find the index of the node with the given id and ability (the number of nodes that come before it)
+     * @param - The ID and ability of the requested node
+     * @return - the index of the node
      */
-    ComplexNode<T>* find_index(ComplexNode<T>* node, const int index);
+    int find_rank(const int id, const int ability) const;
 
 private:
 
@@ -89,6 +107,16 @@ private:
     */
     ComplexNode<T>* make_node_leaf(ComplexNode<T>* node);
 
+    /*
+    * Helper function for find_indices:
+    * Find the indices that belong to the subtree of the given node
+    * @param - the current node, the indices in its subtree and their results, their number,
+    *       and the number of nodes that come before the subtree
+    * @return - void
+    */
+    void find_indices_recursively(ComplexNode<T>* node, const int* indices, T* results, const int numIndices,
+                                  const int offset);
+
     /*
     * Helper function for updating the rank during remove:
     * Starts at a given node and goes up until reaching the root, updating the number of children for each node
@@ -96,6 +124,22 @@ private:
     * @return - void
     */
     void upwardUpdate(ComplexNode<T>* starting);
+
+    /*
+    * Helper function for remove_if:
+    * Update the number of children of a node that was linked into the rebuilt tree
+    * @param - ComplexNode* of the node
+    * @return - void
+    */
+    void update_counts(ComplexNode<T>* node) override;
+
+    /*
+    * Helper function for merge_from:
+    * Check whether a node comes before another node (by ability, and then by ID)
+    * @param - the two nodes
+    * @return - true if the first node comes before the second one, otherwise false
+    */
+    bool comes_before(const ComplexNode<T>* node, const ComplexNode<T>* other) const override;
 };
 
 
@@ -238,25 +282,101 @@ ComplexNode<T>& MultiTree<T>::search_recursively(const int id, const int ability
 //-----------------------------------------Helper Function for world_cup-----------------------------------------
 
 template <class T>
-ComplexNode<T>* MultiTree<T>::find_index(ComplexNode<T>* node, const int index) {
+ComplexNode<T>* MultiTree<T>::find_index(ComplexNode<T>* node, int index) {
+    if (node == nullptr || index < 0 || index >= node->m_numChildren) {
+        return nullptr;
+    }
+    while (node != nullptr) {
+        int leftChildren = 0;
+        if (node->m_left != nullptr) {
+            leftChildren = node->m_left->m_numChildren;
+        }
+        if (index < leftChildren) {
+            node = node->m_left;
+        }
+        else if (index == leftChildren) {
+            return node;
+        }
+        else {
+            index -= leftChildren + 1;
+            node = node->m_right;
+        }
+    }
+    return nullptr;
+}
+
+
+template <class T>
+void MultiTree<T>::find_indices(const int* indices, const int numIndices, T* results) {
+    int first = 0;
+    int last = numIndices;
+    //Indices that are out of the tree's range have no node
+    while (first < last && indices[first] < 0) {
+        results[first++] = T();
+    }
+    while (last > first && indices[last - 1] >= this->m_node->m_numChildren) {
+        results[--last] = T();
+    }
+    find_indices_recursively(this->m_node, indices + first, results + first, last - first, 0);
+}
+
+
+template <class T>
+void MultiTree<T>::find_indices_recursively(ComplexNode<T>* node, const int* indices, T* results,
+                                            const int numIndices, const int offset) {
+    if (node == nullptr || numIndices == 0) {
+        return;
+    }
     int leftChildren = 0;
     if (node->m_left != nullptr) {
         leftChildren = node->m_left->m_numChildren;
     }
-    if (leftChildren > index) {
-        return find_index(node->m_left, index);
+    int nodeIndex = offset + leftChildren;
+    //Split the sorted indices into the ones before the node, the ones equal to it, and the ones after it
+    int low = 0;
+    int high = numIndices;
+    while (low < high) {
+        int middle = low + (high - low) / 2;
+        if (indices[middle] < nodeIndex) {
+            low = middle + 1;
+        }
+        else {
+            high = middle;
+        }
     }
-    else if (index == leftChildren) {
-        return node;
+    int numLeft = low;
+    int numRight = numLeft;
+    while (numRight < numIndices && indices[numRight] == nodeIndex) {
+        results[numRight++] = node->m_data;
     }
-    else {
-        if (node->m_right != nullptr) {
-            return find_index(node->m_right, index-leftChildren-1);
+    find_indices_recursively(node->m_left, indices, results, numLeft, offset);
+    find_indices_recursively(node->m_right, indices + numRight, results + numRight, numIndices - numRight,
+                             nodeIndex + 1);
+}
+
+
+template <class T>
+int MultiTree<T>::find_rank(const int id, const int ability) const {
+    ComplexNode<T>* node = this->m_node;
+    int rank = 0;
+    while (node != nullptr) {
+        int leftChildren = 0;
+        if (node->m_left != nullptr) {
+            leftChildren = node->m_left->m_numChildren;
+        }
+        if (node->m_id == id && node->m_height >= 0) {
+            return rank + leftChildren;
+        }
+        //All of the nodes in the left subtree and the current node come before the requested node
+        if (node->m_ability < ability || (node->m_ability == ability && node->m_id < id)) {
+            rank += leftChildren + 1;
+            node = node->m_right;
         }
         else {
-            return node;
+            node = node->m_left;
         }
     }
+    throw NodeNotFound();
 }
 
 
@@ -368,6 +488,21 @@ ComplexNode<T>* MultiTree<T>::make_node_leaf(ComplexNode<T>* node)
 }
 
 
+template<class T>
+void MultiTree<T>::update_counts(ComplexNode<T>* node) {
+    node->update_children();
+}
+
+
+template<class T>
+bool MultiTree<T>::comes_before(const ComplexNode<T>* node, const ComplexNode<T>* other) const {
+    if (node->m_ability != other->m_ability) {
+        return node->m_ability < other->m_ability;
+    }
+    return node->m_id < other->m_id;
+}
+
+
 template<class T>
 void MultiTree<T>::upwardUpdate(ComplexNode<T>* starting) {
     while (starting != nullptr) {
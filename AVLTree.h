@@ -102,7 +102,42 @@ public:
     */
     void get_all_data(T* const array) const;
 
-private:
+    /*
+     * Remove every node whose ID meets the condition, and link the rest of the nodes into a new balanced tree, in a
+     *       single pass over the tree (instead of a search and a rebalance for every removed node)
+     * @param - the condition: a function that receives the ID of a node, and returns true if it should be removed
+     * @return - the number of removed nodes
+     */
+    template <class Condition>
+    int remove_if(const Condition& condition);
+
+    /*
+     * Move every node of another tree into this tree, in a single sorted merge of the nodes of both trees (instead of
+     *       a search and a rebalance for every moved node), and link the merged nodes into a new balanced tree. The
+     *       other tree is left empty. No ID may be in both trees.
+     * @param - the other tree, a function that receives the data of every moved node (to update it), and an empty
+     *          node for the root of the other tree (deleted if it is not needed), so that the merge itself can't fail
+     * @return - void
+     */
+    template <class Update>
+    void merge_from(Tree& other, const Update& update, N* emptyRoot);
+
+protected:
+
+    /*
+     * Check whether a node comes before another node in the order of the tree
+     * @param - the two nodes
+     * @return - true if the first node comes before the second one, otherwise false
+     */
+    virtual bool comes_before(const N* node, const N* other) const;
+
+    /*
+     * Update the counts that a derived tree keeps in its nodes, after the children of the node changed (the counts
+     *       of the children are already updated)
+     * @param - the node
+     * @return - none
+     */
+    virtual void update_counts(N* node);
 
     /*
     * Make the node a leaf without breaking the sorted tree
@@ -111,6 +146,37 @@ private:
     */
     N* make_node_leaf(N* node);
 
+    /*
+     * Helper function for remove_if:
+     * Recursively walk the subtree backwards (from the highest ID), delete the nodes that meet the condition, and put
+     *       the rest at the start of a list linked by m_right (so that the list is sorted). The last removed node is
+     *       kept as the spare, instead of deleting it.
+     * @param - the root of the subtree, the condition, the list, the spare, and the number of nodes in the list
+     * @return - the number of removed nodes in the subtree
+     */
+    template <class Condition>
+    int unlink_recursively(N* node, const Condition& condition, N*& list, N*& spare, int& numLeft);
+
+    /*
+     * Helper function for remove_if:
+     * Build a balanced tree from the first nodes of a sorted list (the middle node is the root, and the nodes before
+     *       and after it form its subtrees)
+     * @param - the list (advanced past the used nodes), and the number of nodes to use
+     * @return - the root of the new tree (nullptr if there are no nodes)
+     */
+    N* link_balanced(N*& list, const int numNodes);
+
+    /*
+     * Helper function for merge_from:
+     * Build a balanced tree from the first nodes of two sorted lists, merged by the order of the tree, in the same
+     *       single pass as link_balanced (so the lists are not merged into one list first)
+     * @param - the lists (advanced past the used nodes), the function that updates the data of the other tree's nodes,
+     *          and the number of nodes to use
+     * @return - the root of the new tree (nullptr if there are no nodes)
+     */
+    template <class Update>
+    N* link_merged(N*& list, N*& otherList, const Update& update, const int numNodes);
+
 };
 
 
@@ -339,6 +405,156 @@ void Tree<N, T>::get_all_data(T* const array) const
 }
 
 
+template <class N, class T>
+template <class Condition>
+int Tree<N, T>::remove_if(const Condition& condition)
+{
+    if (m_node->m_height == -1) {
+        return 0;
+    }
+    N* list = nullptr;
+    N* spare = nullptr;
+    int numLeft = 0;
+    int numRemoved = unlink_recursively(m_node, condition, list, spare, numLeft);
+    if (numLeft == 0) {
+        //No node is left - the spare becomes the empty root of the tree (without another allocation)
+        spare->~N();
+        m_node = new (spare) N();
+        return numRemoved;
+    }
+    delete spare;
+    m_node = link_balanced(list, numLeft);
+    m_node->m_parent = nullptr;
+    return numRemoved;
+}
+
+
+template <class N, class T>
+template <class Update>
+void Tree<N, T>::merge_from(Tree& other, const Update& update, N* emptyRoot)
+{
+    if (other.m_node->m_height == -1) {
+        delete emptyRoot;
+        return;
+    }
+    //Unlink the nodes of both trees into sorted lists, and link them into one tree while merging them (an empty tree
+    //only has its empty root, which the other tree takes instead of the given one)
+    auto keep = [](const int) { return false; };
+    N* list = nullptr;
+    N* otherList = nullptr;
+    N* spare = nullptr;
+    int numNodes = 0;
+    int numOther = 0;
+    if (m_node->m_height == -1) {
+        delete emptyRoot;
+        emptyRoot = m_node;
+    }
+    else {
+        unlink_recursively(m_node, keep, list, spare, numNodes);
+    }
+    unlink_recursively(other.m_node, keep, otherList, spare, numOther);
+    m_node = link_merged(list, otherList, update, numNodes + numOther);
+    m_node->m_parent = nullptr;
+    emptyRoot->~N();
+    other.m_node = new (emptyRoot) N();
+}
+
+
+template <class N, class T>
+template <class Condition>
+int Tree<N, T>::unlink_recursively(N* node, const Condition& condition, N*& list, N*& spare, int& numLeft)
+{
+    if (node == nullptr) {
+        return 0;
+    }
+    int numRemoved = unlink_recursively(node->m_right, condition, list, spare, numLeft);
+    N* left = node->m_left;
+    if (condition(node->m_id)) {
+        delete spare;
+        spare = node;
+        numRemoved++;
+    }
+    else {
+        node->m_right = list;
+        list = node;
+        numLeft++;
+    }
+    return numRemoved + unlink_recursively(left, condition, list, spare, numLeft);
+}
+
+
+template <class N, class T>
+template <class Update>
+N* Tree<N, T>::link_merged(N*& list, N*& otherList, const Update& update, const int numNodes)
+{
+    if (numNodes == 0) {
+        return nullptr;
+    }
+    N* left = link_merged(list, otherList, update, numNodes / 2);
+    //The next node is the first of the two lists, by the order of the tree
+    N* node;
+    if (list == nullptr || (otherList != nullptr && comes_before(otherList, list))) {
+        node = otherList;
+        otherList = otherList->m_right;
+        update(node->m_data);
+    }
+    else {
+        node = list;
+        list = list->m_right;
+    }
+    N* right = link_merged(list, otherList, update, numNodes - numNodes / 2 - 1);
+    node->m_left = left;
+    node->m_right = right;
+    if (left != nullptr) {
+        left->m_parent = node;
+    }
+    if (right != nullptr) {
+        right->m_parent = node;
+    }
+    node->update_height();
+    node->update_bf();
+    update_counts(node);
+    return node;
+}
+
+
+template <class N, class T>
+N* Tree<N, T>::link_balanced(N*& list, const int numNodes)
+{
+    if (numNodes == 0) {
+        return nullptr;
+    }
+    N* left = link_balanced(list, numNodes / 2);
+    N* node = list;
+    list = list->m_right;
+    N* right = link_balanced(list, numNodes - numNodes / 2 - 1);
+    node->m_left = left;
+    node->m_right = right;
+    if (left != nullptr) {
+        left->m_parent = node;
+    }
+    if (right != nullptr) {
+        right->m_parent = node;
+    }
+    node->update_height();
+    node->update_bf();
+    update_counts(node);
+    return node;
+}
+
+
+template <class N, class T>
+void Tree<N, T>::update_counts(N*)
+{}
+
+
+template <class N, class T>
+bool Tree<N, T>::comes_before(const N* node, const N* other) const
+{
+    return node->m_id < other->m_id;
+}
+
+
 template <class N, class T>
 N* Tree<N, T>::make_node_leaf(N* node)
 {
@@ -2,7 +2,7 @@
 #define COMPLEXNODE_H
 
 #include "Node.h"
-#include "Player.h"
+#include "Teams.h"
 
 /*
 * Class Complex Node : Node
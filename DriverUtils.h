@@ -0,0 +1,203 @@
+#ifndef DRIVERUTILS_H
+#define DRIVERUTILS_H
+
+//
+// Helpers shared by the drivers that have their own main (the tests and the benchmarks, which are not part of the
+// submission): a deterministic pseudo-random generator, building and playing leagues, and counting failed checks.
+//
+
+#include "worldcup23a2.h"
+#include <iostream>
+
+//----------------------------------------------Random-------------------------------------------------
+
+/*
+ * Small deterministic pseudo-random generator, so that every run (and every world of a comparison) replays the
+ *      same operations
+ */
+static unsigned int g_seed = 12345;
+
+inline int next_random(int range)
+{
+    g_seed = g_seed * 1103515245u + 12345u;
+    return (int)((g_seed >> 8) % (unsigned int)range);
+}
+
+inline permutation_t random_spirit()
+{
+    int a[permutation_t::N];
+    for (int i = 0; i < permutation_t::N; i++) {
+        a[i] = i;
+    }
+    for (int i = permutation_t::N - 1; i > 0; i--) {
+        int j = next_random(i + 1);
+        int tmp = a[i];
+        a[i] = a[j];
+        a[j] = tmp;
+    }
+    return permutation_t(a);
+}
+
+/*
+ * Shuffle an array of IDs into a random order
+ */
+inline void shuffle(int* ids, const int size)
+{
+    for (int i = size - 1; i > 0; i--) {
+        int j = next_random(i + 1);
+        int tmp = ids[i];
+        ids[i] = ids[j];
+        ids[j] = tmp;
+    }
+}
+
+/*
+ * Fill an array with random team IDs in [1, numTeams]
+ */
+inline void random_team_ids(int* ids, const int size, const int numTeams)
+{
+    for (int i = 0; i < size; i++) {
+        ids[i] = 1 + next_random(numTeams);
+    }
+}
+
+//----------------------------------------------Leagues------------------------------------------------
+
+/*
+ * Add the teams firstTeam, ..., firstTeam + numTeams - 1, each with playersPerTeam players (with the IDs from
+ *      firstPlayer on, and the first player of every team is a goalkeeper) with random spirits, games in [0, 5),
+ *      abilities in [0, maxAbility) and cards in [0, maxCards)
+ */
+inline void add_league(world_cup_t& world, const int firstTeam, const int numTeams, const int firstPlayer,
+                       const int playersPerTeam, const int maxAbility, const int maxCards)
+{
+    for (int t = 0; t < numTeams; t++) {
+        world.add_team(firstTeam + t);
+        for (int p = 0; p < playersPerTeam; p++) {
+            world.add_player(firstPlayer + t * playersPerTeam + p, firstTeam + t, random_spirit(), next_random(5),
+                             next_random(maxAbility), next_random(maxCards), p == 0);
+        }
+    }
+}
+
+/*
+ * Play random matches between the teams in [firstTeam, lastTeam] (a match of a team that does not exist, or of a
+ *      team against itself, fails and changes nothing)
+ */
+inline void play_random_matches(world_cup_t& world, const int firstTeam, const int lastTeam, const int numMatches)
+{
+    for (int i = 0; i < numMatches; i++) {
+        int team1 = firstTeam + next_random(lastTeam - firstTeam + 1);
+        int team2 = firstTeam + next_random(lastTeam - firstTeam + 1);
+        world.play_match(team1, team2);
+    }
+}
+
+/*
+ * Unite the teams 1, ..., numTeams in rounds until numTeamsLeft teams are left: in every round, pairs of teams of the
+ *      same size play and then the first buys the second (the deepest trees that union by size allows)
+ */
+inline void unite_in_pairs(world_cup_t& world, const int numTeams, const int numTeamsLeft)
+{
+    for (int step = 1; step < numTeams / numTeamsLeft; step *= 2) {
+        for (int t = 1; t + step <= numTeams; t += 2 * step) {
+            world.play_match(t, t + step);
+            world.buy_team(t, t + step);
+        }
+    }
+}
+
+//----------------------------------------------Checks-------------------------------------------------
+
+static int g_failures = 0;
+
+inline void check(bool condition, const char* test, const char* what)
+{
+    if (!condition) {
+        std::cout << "FAILED " << test << ": " << what << std::endl;
+        g_failures++;
+    }
+}
+
+template <class T>
+inline bool same_output(output_t<T> a, output_t<T> b)
+{
+    return a.status() == b.status() && (a.status() != StatusType::SUCCESS || a.ans() == b.ans());
+}
+
+inline bool same_spirit(output_t<permutation_t> a, output_t<permutation_t> b)
+{
+    return a.status() == b.status() && (a.status() != StatusType::SUCCESS || a.ans().strength() == b.ans().strength());
+}
+
+/*
+ * Compare every query of two worlds over the team IDs [1, maxTeamId] and the player IDs [1, maxPlayerId]
+ */
+inline void compare_worlds(world_cup_t& world, world_cup_t& expected, const int maxTeamId, const int maxPlayerId,
+                           const char* test)
+{
+    const int bufferSize = 64;
+    for (int teamId = 1; teamId <= maxTeamId; teamId++) {
+        check(same_output(world.get_team_points(teamId), expected.get_team_points(teamId)), test, "team points");
+        check(same_output(world.get_team_score_rank(teamId), expected.get_team_score_rank(teamId)), test,
+              "team score rank");
+        check(same_output(world.get_team_cards(teamId), expected.get_team_cards(teamId)), test, "team cards");
+        check(same_output(world.get_team_player_games(teamId), expected.get_team_player_games(teamId)), test,
+              "team player games");
+        MatchRecord matches[bufferSize];
+        MatchRecord expectedMatches[bufferSize];
+        output_t<int> numMatches = world.get_last_matches(teamId, bufferSize, matches);
+        output_t<int> expectedNumMatches = expected.get_last_matches(teamId, bufferSize, expectedMatches);
+        check(same_output(numMatches, expectedNumMatches), test, "number of last matches");
+        if (same_output(numMatches, expectedNumMatches) && numMatches.status() == StatusType::SUCCESS) {
+            for (int i = 0; i < numMatches.ans(); i++) {
+                check(matches[i].opponentId == expectedMatches[i].opponentId &&
+                      matches[i].result == expectedMatches[i].result &&
+                      matches[i].score == expectedMatches[i].score &&
+                      matches[i].opponentScore == expectedMatches[i].opponentScore, test, "last matches");
+            }
+        }
+    }
+    for (int i = 0; i <= maxTeamId; i++) {
+        check(same_output(world.get_ith_pointless_ability(i), expected.get_ith_pointless_ability(i)), test,
+              "ith pointless ability");
+        check(same_output(world.get_ith_team_by_score(i), expected.get_ith_team_by_score(i)), test,
+              "ith team by score");
+    }
+    for (int minTeamId = 1; minTeamId <= maxTeamId; minTeamId += 7) {
+        check(same_output(world.knockout_winner(minTeamId, maxTeamId), expected.knockout_winner(minTeamId, maxTeamId)),
+              test, "knockout winner");
+    }
+    for (int playerId = 1; playerId <= maxPlayerId; playerId++) {
+        check(same_output(world.num_played_games_for_player(playerId),
+                          expected.num_played_games_for_player(playerId)), test, "player games");
+        check(same_output(world.get_player_cards(playerId), expected.get_player_cards(playerId)), test,
+              "player cards");
+        check(same_spirit(world.get_partial_spirit(playerId), expected.get_partial_spirit(playerId)), test,
+              "partial spirit");
+    }
+}
+
+/*
+ * Print whether the two sides of a benchmark gave the same results
+ */
+inline void print_results(const bool same)
+{
+    std::cout << (same ? "results match" : "RESULTS DIFFER") << std::endl;
+}
+
+/*
+ * Print the number of failed checks of a test driver
+ * @return - the exit code of the driver: 0 if every check passed, else 1
+ */
+inline int report_checks()
+{
+    if (g_failures > 0) {
+        std::cout << g_failures << " checks failed" << std::endl;
+        return 1;
+    }
+    std::cout << "All checks passed" << std::endl;
+    return 0;
+}
+
+#endif //DRIVERUTILS_H
@@ -0,0 +1,233 @@
+#include "FrozenSnapshot.h"
+
+namespace {
+
+    /*
+     * The first level of the players table is rebuilt until the sum of the squared bucket sizes (the size of the
+     * second level) is at most this many slots per player. A universal hash function expects less than 2.
+     */
+    const int MAX_SLOTS_PER_PLAYER = 4;
+
+    /*
+     * The number of ints in a single cache line: the Eytzinger descent prefetches the node 4 levels down
+     */
+    const int INTS_PER_CACHE_LINE = 16;
+
+}
+
+//--------------------------------Constructor and Destructor------------------------------------
+
+FrozenSnapshot::FrozenSnapshot(const int* teamIds, const int* teamPoints, const int* rankedTeamIds,
+                               const int numTeams, const int* playerIds, const int* playerCards,
+                               const int numPlayers) :
+    m_teamIds(nullptr),
+    m_teamPoints(nullptr),
+    m_numTeams(numTeams),
+    m_rankedTeamIds(nullptr),
+    m_bucketSeed(1),
+    m_numBuckets(numPlayers > 0 ? numPlayers : 1),
+    m_bucketOffsets(nullptr),
+    m_bucketSeeds(nullptr),
+    m_playerIds(nullptr),
+    m_playerCards(nullptr),
+    m_randomState(12345)
+{
+    try {
+        m_teamIds = new int[numTeams + 1];
+        m_teamPoints = new int[numTeams + 1];
+        m_rankedTeamIds = new int[numTeams + 1];
+        build_players(playerIds, playerCards, numPlayers);
+    }
+    catch (const std::bad_alloc& e) {
+        delete[] m_teamIds;
+        delete[] m_teamPoints;
+        delete[] m_rankedTeamIds;
+        delete[] m_bucketOffsets;
+        delete[] m_bucketSeeds;
+        delete[] m_playerIds;
+        delete[] m_playerCards;
+        throw e;
+    }
+    m_teamIds[0] = 0;
+    m_teamPoints[0] = 0;
+    build_eytzinger(teamIds, teamPoints, 0, 1);
+    for (int i = 0; i < numTeams; i++) {
+        m_rankedTeamIds[i] = rankedTeamIds[i];
+    }
+}
+
+
+FrozenSnapshot::~FrozenSnapshot()
+{
+    delete[] m_teamIds;
+    delete[] m_teamPoints;
+    delete[] m_rankedTeamIds;
+    delete[] m_bucketOffsets;
+    delete[] m_bucketSeeds;
+    delete[] m_playerIds;
+    delete[] m_playerCards;
+}
+
+
+//-----------------------------------------Search Functions-----------------------------------------
+
+int FrozenSnapshot::get_team_points(const int teamId) const
+{
+    //Descend without branching on the comparison: the left child of node is 2*node and the right is 2*node+1
+    int node = 1;
+    while (node <= m_numTeams) {
+        __builtin_prefetch(m_teamIds + INTS_PER_CACHE_LINE * node);
+        node = 2 * node + (m_teamIds[node] < teamId);
+    }
+    //Cancel the right turns made after the last left turn, which was made at the smallest ID >= teamId
+    node >>= __builtin_ffs(~node);
+    if (node == 0 || m_teamIds[node] != teamId) {
+        throw NodeNotFound();
+    }
+    return m_teamPoints[node];
+}
+
+
+int FrozenSnapshot::get_ith_team(const int index) const
+{
+    return m_rankedTeamIds[index];
+}
+
+
+int FrozenSnapshot::get_player_cards(const int playerId) const
+{
+    int bucket = hash_function(playerId, m_bucketSeed, m_numBuckets);
+    int firstSlot = m_bucketOffsets[bucket];
+    int numSlots = m_bucketOffsets[bucket + 1] - firstSlot;
+    if (numSlots == 0) {
+        throw NodeNotFound();
+    }
+    int slot = firstSlot + hash_function(playerId, m_bucketSeeds[bucket], numSlots);
+    if (m_playerIds[slot] != playerId) {
+        throw NodeNotFound();
+    }
+    return m_playerCards[slot];
+}
+
+
+//-----------------------------------------Helper Functions-----------------------------------------
+
+int FrozenSnapshot::build_eytzinger(const int* teamIds, const int* teamPoints, int index, const int node)
+{
+    if (node > m_numTeams) {
+        return index;
+    }
+    index = build_eytzinger(teamIds, teamPoints, index, 2 * node);
+    m_teamIds[node] = teamIds[index];
+    m_teamPoints[node] = teamPoints[index];
+    index++;
+    return build_eytzinger(teamIds, teamPoints, index, 2 * node + 1);
+}
+
+
+void FrozenSnapshot::build_players(const int* playerIds, const int* playerCards, const int numPlayers)
+{
+    int* bucketSizes = new int[m_numBuckets];
+    int* order = nullptr;
+    try {
+        order = new int[numPlayers + 1];
+        m_bucketOffsets = new int[m_numBuckets + 1];
+        m_bucketSeeds = new unsigned int[m_numBuckets];
+    }
+    catch (const std::bad_alloc& e) {
+        delete[] bucketSizes;
+        delete[] order;
+        throw e;
+    }
+    //First level: pick a seed that spreads the players well enough over the buckets
+    long long numSlots;
+    do {
+        m_bucketSeed = next_seed();
+        for (int b = 0; b < m_numBuckets; b++) {
+            bucketSizes[b] = 0;
+        }
+        for (int i = 0; i < numPlayers; i++) {
+            bucketSizes[hash_function(playerIds[i], m_bucketSeed, m_numBuckets)]++;
+        }
+        numSlots = 0;
+        for (int b = 0; b < m_numBuckets; b++) {
+            numSlots += (long long)bucketSizes[b] * bucketSizes[b];
+        }
+    } while (numSlots > (long long)MAX_SLOTS_PER_PLAYER * numPlayers);
+    //A bucket of s players gets s^2 slots, so a random seed has no collisions with probability over 1/2
+    m_bucketOffsets[0] = 0;
+    for (int b = 0; b < m_numBuckets; b++) {
+        m_bucketOffsets[b + 1] = m_bucketOffsets[b] + bucketSizes[b] * bucketSizes[b];
+    }
+    try {
+        m_playerIds = new int[numSlots + 1];
+        m_playerCards = new int[numSlots + 1];
+    }
+    catch (const std::bad_alloc& e) {
+        delete[] bucketSizes;
+        delete[] order;
+        throw e;
+    }
+    for (int i = 0; i <= numSlots; i++) {
+        m_playerIds[i] = 0;
+        m_playerCards[i] = 0;
+    }
+    //Group the players by bucket (counting sort), reusing bucketSizes as the next free place of every bucket
+    int start = 0;
+    for (int b = 0; b < m_numBuckets; b++) {
+        int size = bucketSizes[b];
+        bucketSizes[b] = start;
+        start += size;
+    }
+    for (int i = 0; i < numPlayers; i++) {
+        order[bucketSizes[hash_function(playerIds[i], m_bucketSeed, m_numBuckets)]++] = i;
+    }
+    //Second level: pick a seed for every bucket that places its players without collisions
+    int first = 0;
+    for (int b = 0; b < m_numBuckets; b++) {
+        int last = bucketSizes[b];
+        int bucketSlots = m_bucketOffsets[b + 1] - m_bucketOffsets[b];
+        bool placed = (first == last);
+        while (!placed) {
+            m_bucketSeeds[b] = next_seed();
+            placed = true;
+            int i = first;
+            for (; i < last; i++) {
+                int slot = m_bucketOffsets[b] + hash_function(playerIds[order[i]], m_bucketSeeds[b], bucketSlots);
+                if (m_playerIds[slot] != 0) {
+                    placed = false;
+                    break;
+                }
+                m_playerIds[slot] = playerIds[order[i]];
+                m_playerCards[slot] = playerCards[order[i]];
+            }
+            if (!placed) {
+                for (int j = first; j < i; j++) {
+                    int slot = m_bucketOffsets[b] + hash_function(playerIds[order[j]], m_bucketSeeds[b], bucketSlots);
+                    m_playerIds[slot] = 0;
+                }
+            }
+        }
+        if (first == last) {
+            m_bucketSeeds[b] = 1;
+        }
+        first = last;
+    }
+    delete[] bucketSizes;
+    delete[] order;
+}
+
+
+unsigned int FrozenSnapshot::next_seed()
+{
+    m_randomState = m_randomState * 1103515245u + 12345u;
+    return (m_randomState ^ (m_randomState >> 16)) | 1u;
+}
+
+
+int FrozenSnapshot::hash_function(const int id, const unsigned int seed, const int size)
+{
+    //Multiply-shift: the high bits of the product are well mixed, and they are mapped to [0, size) without a modulo
+    unsigned int mixed = (unsigned int)id * seed;
+    return (int)(((unsigned long long)mixed * (unsigned int)size) >> 32);
+}
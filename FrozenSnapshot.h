@@ -0,0 +1,118 @@
+#ifndef FROZENSNAPSHOT_H
+#define FROZENSNAPSHOT_H
+
+#include <new>
+#include "Exception.h"
+
+/*
+* Class FrozenSnapshot
+* This class is used as a read-only copy of world_cup, built by freeze() for phases in which there are (almost) only
+*       get_team_points, get_ith_pointless_ability and get_player_cards queries. It is discarded on the next write.
+* The team IDs are saved in Eytzinger (BFS) order, so a search is a branch-free descent over a single array whose
+*       next levels can be prefetched. The teams sorted by ability are saved in a plain array, so the i'th team is
+*       a single read. The players are saved in a two-level perfect hash table (FKS), so a player is found with
+*       two multiplications and a single comparison, without any probing.
+*/
+class FrozenSnapshot {
+public:
+
+    /*
+    * Constructor of FrozenSnapshot class
+    * @param - the team IDs (sorted) and their points, the team IDs sorted by ability, the number of teams,
+    *          the player IDs and their cards, and the number of players
+    * @return - A new instance of FrozenSnapshot
+    */
+    FrozenSnapshot(const int* teamIds, const int* teamPoints, const int* rankedTeamIds, const int numTeams,
+                   const int* playerIds, const int* playerCards, const int numPlayers);
+
+    /*
+    * Copy Constructor and Assignment Operator of FrozenSnapshot class
+    * world_cup does not allow two of the same player or team (repeating ID's).
+    * Therefore the system does not allow a copy constructor or assignment operator.
+    */
+    FrozenSnapshot(const FrozenSnapshot& other) = delete;
+    FrozenSnapshot& operator=(const FrozenSnapshot& other) = delete;
+
+    /*
+    * Destructor of FrozenSnapshot class
+    * @param - none
+    * @return - void
+    */
+    ~FrozenSnapshot();
+
+    /*
+     * Search for the points of a team
+     * @param - The ID of the team
+     * @return - the points of the team
+     */
+    int get_team_points(const int teamId) const;
+
+    /*
+     * Find the team that has the given index, when the teams are sorted by ability and then by ID
+     * @param - The index (already checked to be in range)
+     * @return - the ID of the team
+     */
+    int get_ith_team(const int index) const;
+
+    /*
+     * Search for the cards of a player
+     * @param - The ID of the player
+     * @return - the cards of the player
+     */
+    int get_player_cards(const int playerId) const;
+
+private:
+
+    /*
+     * Helper function for the constructor:
+     * Recursively place the sorted teams in Eytzinger order (an in-order walk of the implicit tree)
+     * @param - the sorted team IDs and points, the index of the next sorted team, and the current node (1-based)
+     * @return - the index of the next sorted team
+     */
+    int build_eytzinger(const int* teamIds, const int* teamPoints, int index, const int node);
+
+    /*
+     * Helper function for the constructor:
+     * Build the two-level perfect hash table of the players
+     * @param - the player IDs and their cards, and the number of players
+     * @return - void
+     */
+    void build_players(const int* playerIds, const int* playerCards, const int numPlayers);
+
+    /*
+     * Return the next seed for the hash functions (an odd number, from a fixed pseudo-random sequence)
+     * @param - none
+     * @return - the seed
+     */
+    unsigned int next_seed();
+
+    /*
+     * Hash an ID into the range [0, size), using the given seed (multiply-shift)
+     * @param - The ID, the seed and the size of the range
+     * @return - the slot of the ID
+     */
+    static int hash_function(const int id, const unsigned int seed, const int size);
+
+    /*
+     * The internal fields of FrozenSnapshot:
+     *   The team IDs and their points in Eytzinger order (1-based), and the number of teams
+     *   The team IDs sorted by ability and then by ID
+     *   The seed of the first level of the players table and its number of buckets
+     *   The first slot of every bucket (the bucket's slots end where the next bucket's slots begin) and its seed
+     *   The player IDs (0 marks an empty slot) and their cards in every slot of the second level
+     *   The state of the pseudo-random sequence of seeds
+     */
+    int* m_teamIds;
+    int* m_teamPoints;
+    int m_numTeams;
+    int* m_rankedTeamIds;
+    unsigned int m_bucketSeed;
+    int m_numBuckets;
+    int* m_bucketOffsets;
+    unsigned int* m_bucketSeeds;
+    int* m_playerIds;
+    int* m_playerCards;
+    unsigned int m_randomState;
+};
+
+#endif //FROZENSNAPSHOT_H
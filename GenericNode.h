@@ -6,17 +6,21 @@
 
 /*
 * Class Tree : Generic Node
-* This class is used to create the separate nodes in a basic AVL tree.
+* This class is used to create the separate nodes in a basic AVL tree: the links between the nodes, the rotations
+*       and the height and balance factor.
+* N is the class of the nodes that are linked (a class that derives from GenericNode<T, N>). A node that keeps more
+*       stats of its subtree hides update_counts with its own version, which the rotations call for the two nodes
+*       whose subtrees change.
 */
-template <class T>
-class GenericNode : Node<T> {
+template <class T, class N>
+class GenericNode : protected Node<T> {
 public:
 
     /*
     * Constructor of GenericNode class
     * @param - none
     * @return - A new instance of GenericNode
-    */ 
+    */
     GenericNode();
 
     /*
@@ -24,7 +28,7 @@ public:
     * Used in unite_teams to make a new node containing the desired player
     * @param - data the node holds
     * @return - A new instance of GenericNode
-    */   
+    */
     GenericNode(T data);
 
     /*
@@ -49,35 +53,35 @@ public:
     */
     int get_height() const;
 
-private:
+protected:
 
     /*
-     * Left-Right Rotation
+     * Left-Left Rotation
      * @param - Node with balance factor of +2
-     * @return - pointer to ComplexNode
+     * @return - pointer to the root of the tree
      */
-    GenericNode* ll_rotation(GenericNode* node);
+    N* ll_rotation(N* node);
 
     /*
      * Right-Right Rotation
      * @param - Node with balance factor of -2
-     * @return - pointer to ComplexNode
+     * @return - pointer to the root of the tree
      */
-    GenericNode* rr_rotation(GenericNode* node);
+    N* rr_rotation(N* node);
 
     /*
      * Right-Left Rotation
      * @param - Node with balance factor of -2
-     * @return - pointer to ComplexNode
+     * @return - pointer to the root of the tree
     */
-    GenericNode* rl_rotation(GenericNode* node);
+    N* rl_rotation(N* node);
 
     /*
-     * Left-Left Rotation
+     * Left-Right Rotation
      * @param - Node with balance factor of +2
-     * @return - pointer to ComplexNode
+     * @return - pointer to the root of the tree
     */
-    GenericNode* lr_rotation(GenericNode* node);
+    N* lr_rotation(N* node);
 
     /*
      * Update balance factor of the current node
@@ -85,7 +89,7 @@ private:
      * @return - void
     */
     void update_bf();
-    
+
     /*
      * Update height of the current node
      * @param - none
@@ -94,9 +98,16 @@ private:
     void update_height();
 
     /*
-    * Helper function for enlarge_hash_table in world_cup:
-    * Recursively insert all the players in tree into the given array
-    * @param - array of Players, integer of the current index in the array
+     * Update the stats of the subtree of the current node from its children (a basic node has none)
+     * @param - none
+     * @return - void
+    */
+    void update_counts();
+
+    /*
+    * Helper function for get_all_data:
+    * Recursively insert all the data in the subtree into the given array
+    * @param - array of data, integer of the current index in the array
     * @return - current index in the array.
     */
     int get_data_inorder(T* array, int index) const;
@@ -104,56 +115,69 @@ private:
     /*
      * The internal fields of GenericNode: pointers to the parent node and two child nodes
      */
-    GenericNode* m_parent;
-    GenericNode* m_left;
-    GenericNode* m_right;
+    N* m_parent;
+    N* m_left;
+    N* m_right;
 
     /*
      * The following class is a friend class in order to allow full access to private fields and functions of
      * GenericNode, allowing GenericNode to be a mostly private class, while allowing the system to run smoothly.
     */
-    template <class N, class M>
+    template <class S, class M>
     friend class Tree;
 
+private:
+
+    /*
+     * The node as the class of the nodes that are linked
+     * @param - none
+     * @return - pointer to the node
+     */
+    N* self();
 };
 
 //--------------------------------------------Constructors---------------------------------------------------
 
-template <class T>
-GenericNode<T>::GenericNode() :
+template <class T, class N>
+GenericNode<T, N>::GenericNode() :
         Node<T>(),
         m_parent(nullptr),
         m_left(nullptr),
         m_right(nullptr)
 {}
 
-template <class T>
-GenericNode<T>::GenericNode(T data) :
+template <class T, class N>
+GenericNode<T, N>::GenericNode(T data) :
         Node<T>(data),
         m_parent(nullptr),
         m_left(nullptr),
         m_right(nullptr)
 {}
 
-//-------------------------------------------------------------------------------------MOVE------------------------------
-template<class T>
-int GenericNode<T>::get_height() const {
+template <class T, class N>
+int GenericNode<T, N>::get_height() const {
     return this->m_height;
 }
 
 
+template <class T, class N>
+N* GenericNode<T, N>::self() {
+    return static_cast<N*>(this);
+}
+
+
 //--------------------------------------------Rotations---------------------------------------------------
 
 //Left-Left tree rotation, on the node with balance factor of +2
-template <class T>
-typename GenericNode<T>::GenericNode* GenericNode<T>::ll_rotation(GenericNode<T>* node)
+template <class T, class N>
+N* GenericNode<T, N>::ll_rotation(N* node)
 {
-    GenericNode<T>* tmpToReturn = node;
+    N* tmpToReturn = node;
     //Changing A->B to A->Parent
     m_left->m_parent = m_parent;
     //Changing Parent->B to Parent->A
     if (m_parent != nullptr) {
-        if (m_parent->m_left == this) {
+        if (m_parent->m_left == self()) {
             m_parent->m_left = m_left;
         }
         else {
@@ -167,24 +191,27 @@ typename GenericNode<T>::GenericNode* GenericNode<T>::ll_rotation(GenericNode<T>
     m_parent = m_left;
     //Changing Ar->A to Ar->B
     if (m_left->m_right != nullptr) {
-        m_left->m_right->m_parent = this;
+        m_left->m_right->m_parent = self();
     }
     //Changing B->A to B->Ar
     m_left = m_left->m_right;
     //Changing A->Ar to A->B
-    m_parent->m_right = this;
+    m_parent->m_right = self();
+    //The node is now the child of its former child: update the node first
+    self()->update_counts();
+    m_parent->update_counts();
     return tmpToReturn;
 }
 
 
 //Right-Right tree rotation, on the node with balance factor of -2
-template <class T>
-typename GenericNode<T>::GenericNode* GenericNode<T>::rr_rotation(GenericNode<T>* node)
+template <class T, class N>
+N* GenericNode<T, N>::rr_rotation(N* node)
 {
-    GenericNode<T>* tmpToReturn = node;
+    N* tmpToReturn = node;
     m_right->m_parent = m_parent;
     if (m_parent != nullptr) {
-        if (m_parent->m_right == this) {
+        if (m_parent->m_right == self()) {
             m_parent->m_right = m_right;
         }
         else {
@@ -196,29 +223,31 @@ typename GenericNode<T>::GenericNode* GenericNode<T>::rr_rotation(GenericNode<T>
     }
     m_parent = m_right;
     if(m_right->m_left != nullptr) {
-        m_right->m_left->m_parent = this;
+        m_right->m_left->m_parent = self();
     }
     m_right = m_right->m_left;
-    m_parent->m_left = this;
+    m_parent->m_left = self();
+    self()->update_counts();
+    m_parent->update_counts();
     return tmpToReturn;
 }
 
 
 //Right-Left tree rotation, on the node with balance factor of -2
-template <class T>
-typename GenericNode<T>::GenericNode* GenericNode<T>::rl_rotation(GenericNode<T>* node)
+template <class T, class N>
+N* GenericNode<T, N>::rl_rotation(N* node)
 {
-    GenericNode<T>* tmp = m_right->ll_rotation(node);
+    N* tmp = m_right->ll_rotation(node);
     tmp = rr_rotation(tmp);
     return tmp;
 }
 
 
 //Left-Right tree rotation, on the node with balance factor of +2
-template <class T>
-typename GenericNode<T>::GenericNode* GenericNode<T>::lr_rotation(GenericNode<T>* node)
+template <class T, class N>
+N* GenericNode<T, N>::lr_rotation(N* node)
 {
-    GenericNode<T>* tmp = m_left->rr_rotation(node);
+    N* tmp = m_left->rr_rotation(node);
     tmp = ll_rotation(tmp);
     return tmp;
 }
@@ -227,8 +256,8 @@ typename GenericNode<T>::GenericNode* GenericNode<T>::lr_rotation(GenericNode<T>
 //----------------------------------------------Node Stats---------------------------------------------------
 
 //Update the balance factor of the specific node
-template <class T>
-void GenericNode<T>::update_bf()
+template <class T, class N>
+void GenericNode<T, N>::update_bf()
 {
     int heightLeft = 0, heightRight = 0;
     if (m_left != nullptr) {
@@ -242,8 +271,8 @@ void GenericNode<T>::update_bf()
 
 
 //Update the subtree height of the specific node
-template <class T>
-void GenericNode<T>::update_height()
+template <class T, class N>
+void GenericNode<T, N>::update_height()
 {
     int heightLeft = 0, heightRight = 0;
     if (m_left != nullptr) {
@@ -261,14 +290,23 @@ void GenericNode<T>::update_height()
 }
 
 
+template <class T, class N>
+void GenericNode<T, N>::update_counts()
+{}
+
+
 //---------------------------------------Helper Function for world_cup------------------------------------------------
 
-template <class T>
-int GenericNode<T>::get_data_inorder(T* array, int index) const
+template <class T, class N>
+int GenericNode<T, N>::get_data_inorder(T* array, int index) const
 {
-    if (this != nullptr) {
+    if (m_left != nullptr) {
         index = m_left->get_data_inorder(array, index);
+    }
+    if (this->m_height >= 0) {
         array[index++] = this->m_data;
+    }
+    if (m_right != nullptr) {
         index = m_right->get_data_inorder(array, index);
     }
     return index;
@@ -0,0 +1,300 @@
+#ifndef HASHINDEX_H
+#define HASHINDEX_H
+
+#include <new>
+#include "Exception.h"
+
+/*
+* Class HashIndex
+* This class is used to create a flat hash table that maps positive integer IDs to data of type T.
+* Collisions are resolved with linear probing, so a lookup normally touches a single cache line.
+*/
+template <class T>
+class HashIndex {
+public:
+
+    /*
+    * Constructor of HashIndex class
+    * @param - none
+    * @return - A new instance of HashIndex
+    */
+    HashIndex();
+
+    /*
+    * Copy Constructor and Assignment Operator of HashIndex class
+    * world_cup does not allow two of the same player or team (repeating ID's).
+    * Therefore the system does not allow a copy constructor or assignment operator.
+    */
+    HashIndex(const HashIndex& other) = delete;
+    HashIndex& operator=(const HashIndex& other) = delete;
+
+    /*
+    * Destructor of HashIndex class
+    * @param - none
+    * @return - void
+    */
+    ~HashIndex();
+
+    /*
+     * Insert new data, according to the id given
+     * @param - The ID (must be positive) and the data to insert
+     * @return - void
+     */
+    void insert(const int id, const T& data);
+
+    /*
+     * Remove the data saved under the id given
+     * @param - The ID of the data that needs to be removed
+     * @return - void
+     */
+    void remove(const int id);
+
+    /*
+     * Search for the data saved under the id given
+     * @param - The ID of the requested data
+     * @return - pointer to the data, or nullptr if the ID does not exist
+     */
+    T* find(const int id) const;
+
+    /*
+     * Search for the data saved under the id given
+     * @param - The ID of the requested data
+     * @return - a reference to the data
+     */
+    T& search_and_return_data(const int id) const;
+
+    /*
+     * Return the number of IDs saved in the table
+     * @param - none
+     * @return - the number of IDs
+     */
+    int get_size() const;
+
+    /*
+     * Make sure the table can hold the given number of IDs without being enlarged again
+     * @param - the expected number of IDs
+     * @return - void
+     */
+    void reserve(const int numIds);
+
+    /*
+     * Remove all of the IDs from the table
+     * @param - none
+     * @return - void
+     */
+    void clear();
+
+private:
+
+    /*
+    * Calculate the first slot of an ID in the table: the high bits of the ID multiplied by a constant (the low bits
+    *       of the product only depend on the low bits of the ID, so IDs with the same low bits would share slots)
+    * @return - integer that is equal to the ID's first slot in the table
+    */
+    int hash_function(const int id) const;
+
+    /*
+    * Rebuild the table with the given capacity (a power of 2), re-inserting all of the saved IDs
+    * @return - void
+    */
+    void rehash(const int newCapacity);
+
+    /*
+     * The internal fields of HashIndex:
+     *   The IDs saved in each slot (0 marks an empty slot)
+     *   The data saved in each slot
+     *   The number of slots in the table (always a power of 2), and the shift of the hash that leaves
+     *       log2(m_capacity) bits
+     *   The number of IDs saved in the table
+     */
+    int* m_ids;
+    T* m_data;
+    int m_capacity;
+    int m_shift;
+    int m_size;
+};
+
+
+//--------------------------------Constructor and Destructor------------------------------------
+
+template <class T>
+HashIndex<T>::HashIndex() :
+    m_ids(nullptr),
+    m_data(nullptr),
+    m_capacity(0),
+    m_shift(32),
+    m_size(0)
+{
+    rehash(8);
+}
+
+
+template <class T>
+HashIndex<T>::~HashIndex()
+{
+    delete[] m_ids;
+    delete[] m_data;
+}
+
+
+//----------------------------------Insert and Remove---------------------------------
+
+template <class T>
+void HashIndex<T>::insert(const int id, const T& data)
+{
+    //Keep the load factor under 1/2 so that probe sequences stay short
+    if (2 * (m_size + 1) > m_capacity) {
+        rehash(m_capacity * 2);
+    }
+    int slot = hash_function(id);
+    while (m_ids[slot] != 0) {
+        if (m_ids[slot] == id) {
+            throw InvalidID();
+        }
+        slot = (slot + 1) & (m_capacity - 1);
+    }
+    m_ids[slot] = id;
+    m_data[slot] = data;
+    m_size++;
+}
+
+
+template <class T>
+void HashIndex<T>::remove(const int id)
+{
+    int slot = hash_function(id);
+    while (m_ids[slot] != id) {
+        if (m_ids[slot] == 0) {
+            throw NodeNotFound();
+        }
+        slot = (slot + 1) & (m_capacity - 1);
+    }
+    //Shift the following IDs of the probe sequence back, so that no tombstones are needed
+    int hole = slot;
+    int next = (slot + 1) & (m_capacity - 1);
+    while (m_ids[next] != 0) {
+        int home = hash_function(m_ids[next]);
+        //Move the ID into the hole only if its home slot is not between the hole and its current slot
+        if (((next - home) & (m_capacity - 1)) >= ((next - hole) & (m_capacity - 1))) {
+            m_ids[hole] = m_ids[next];
+            m_data[hole] = m_data[next];
+            hole = next;
+        }
+        next = (next + 1) & (m_capacity - 1);
+    }
+    m_ids[hole] = 0;
+    m_data[hole] = T();
+    m_size--;
+}
+
+
+//-----------------------------------------Search Functions-----------------------------------------
+
+template <class T>
+T* HashIndex<T>::find(const int id) const
+{
+    int slot = hash_function(id);
+    while (m_ids[slot] != 0) {
+        if (m_ids[slot] == id) {
+            return &m_data[slot];
+        }
+        slot = (slot + 1) & (m_capacity - 1);
+    }
+    return nullptr;
+}
+
+
+template <class T>
+T& HashIndex<T>::search_and_return_data(const int id) const
+{
+    T* data = find(id);
+    if (data == nullptr) {
+        throw NodeNotFound();
+    }
+    return *data;
+}
+
+
+template <class T>
+int HashIndex<T>::get_size() const
+{
+    return m_size;
+}
+
+
+//-----------------------------------------Helper Functions-----------------------------------------
+
+template <class T>
+void HashIndex<T>::reserve(const int numIds)
+{
+    int newCapacity = m_capacity;
+    while (2 * numIds > newCapacity) {
+        newCapacity *= 2;
+    }
+    if (newCapacity != m_capacity) {
+        rehash(newCapacity);
+    }
+}
+
+
+template <class T>
+void HashIndex<T>::clear()
+{
+    for (int i = 0; i < m_capacity; i++) {
+        m_ids[i] = 0;
+        m_data[i] = T();
+    }
+    m_size = 0;
+}
+
+
+template <class T>
+int HashIndex<T>::hash_function(const int id) const
+{
+    //Multiplicative hashing spreads consecutive (and strided) IDs over the whole table
+    return (int)(((unsigned int)id * 2654435761u) >> m_shift);
+}
+
+
+template <class T>
+void HashIndex<T>::rehash(const int newCapacity)
+{
+    int* newIds = new int[newCapacity];
+    T* newData;
+    try {
+        newData = new T[newCapacity];
+    }
+    catch (const std::bad_alloc& e) {
+        delete[] newIds;
+        throw e;
+    }
+    for (int i = 0; i < newCapacity; i++) {
+        newIds[i] = 0;
+    }
+    int* oldIds = m_ids;
+    T* oldData = m_data;
+    int oldCapacity = m_capacity;
+    m_ids = newIds;
+    m_data = newData;
+    m_capacity = newCapacity;
+    m_shift = 32;
+    for (int bits = newCapacity; bits > 1; bits /= 2) {
+        m_shift--;
+    }
+    for (int i = 0; i < oldCapacity; i++) {
+        if (oldIds[i] != 0) {
+            int slot = hash_function(oldIds[i]);
+            while (m_ids[slot] != 0) {
+                slot = (slot + 1) & (m_capacity - 1);
+            }
+            m_ids[slot] = oldIds[i];
+            m_data[slot] = oldData[i];
+        }
+    }
+    delete[] oldIds;
+    delete[] oldData;
+}
+
+//----------------------------------------------------------------------------------------------
+
+#endif //HASHINDEX_H
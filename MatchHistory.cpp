@@ -0,0 +1,372 @@
+#include "MatchHistory.h"
+#include "Teams.h"
+
+namespace {
+
+    /*
+     * Copy the first size elements of an array to a new one, and free the old array
+     */
+    template <class T>
+    void move_array(T*& array, T* newArray, const int size)
+    {
+        for (int i = 0; i < size; i++) {
+            newArray[i] = array[i];
+        }
+        delete[] array;
+        array = newArray;
+    }
+
+}
+
+//--------------------------------Constructor and Destructor------------------------------------
+
+MatchHistory::MatchHistory() :
+    m_firstTeams(nullptr),
+    m_secondTeams(nullptr),
+    m_results(nullptr),
+    m_firstScores(nullptr),
+    m_secondScores(nullptr),
+    m_firstPrevious(nullptr),
+    m_secondPrevious(nullptr),
+    m_size(0),
+    m_capacity(0),
+    m_teamIds(nullptr),
+    m_numTeams(0),
+    m_teamCapacity(0),
+    m_pairKeys(nullptr),
+    m_pairRecords(nullptr),
+    m_numPairs(0),
+    m_pairCapacity(0),
+    m_numIndexed(0)
+{
+    enlarge(16);
+    enlarge_teams(16);
+    rehash_pairs(16);
+}
+
+
+MatchHistory::~MatchHistory()
+{
+    delete[] m_firstTeams;
+    delete[] m_secondTeams;
+    delete[] m_results;
+    delete[] m_firstScores;
+    delete[] m_secondScores;
+    delete[] m_firstPrevious;
+    delete[] m_secondPrevious;
+    delete[] m_teamIds;
+    delete[] m_pairKeys;
+    delete[] m_pairRecords;
+}
+
+
+//------------------------------------------Recording-------------------------------------------
+
+int MatchHistory::add_team(const int teamId)
+{
+    if (m_numTeams == m_teamCapacity) {
+        enlarge_teams(m_teamCapacity * 2);
+    }
+    m_teamIds[m_numTeams] = teamId;
+    return m_numTeams++;
+}
+
+
+void MatchHistory::remove_last_team()
+{
+    m_numTeams--;
+}
+
+
+void MatchHistory::reserve(const int numMatches)
+{
+    int newCapacity = m_capacity;
+    while (newCapacity - m_size < numMatches) {
+        newCapacity *= 2;
+    }
+    if (newCapacity != m_capacity) {
+        enlarge(newCapacity);
+    }
+}
+
+
+void MatchHistory::reserve_teams(const int numTeams)
+{
+    int newCapacity = m_teamCapacity;
+    while (newCapacity - m_numTeams < numTeams) {
+        newCapacity *= 2;
+    }
+    if (newCapacity != m_teamCapacity) {
+        enlarge_teams(newCapacity);
+    }
+}
+
+
+void MatchHistory::record(Team* team1, Team* team2, const int result, const int score1, const int score2)
+{
+    if (m_size == m_capacity) {
+        enlarge(m_capacity * 2);
+    }
+    record_at(extend(1), team1, team2, result, score1, score2);
+}
+
+
+int MatchHistory::extend(const int numMatches)
+{
+    int first = m_size;
+    m_size += numMatches;
+    return first;
+}
+
+
+void MatchHistory::record_at(const int match, Team* team1, Team* team2, const int result, const int score1,
+                             const int score2)
+{
+    m_firstTeams[match] = team1->get_history_id();
+    m_secondTeams[match] = team2->get_history_id();
+    m_results[match] = result;
+    m_firstScores[match] = score1;
+    m_secondScores[match] = score2;
+    m_firstPrevious[match] = team1->get_last_match();
+    m_secondPrevious[match] = team2->get_last_match();
+    team1->update_last_match(match);
+    team2->update_last_match(match);
+}
+
+
+void MatchHistory::append(const MatchHistory& other)
+{
+    for (int i = 0; i < other.m_size; i++) {
+        int match = m_size + i;
+        m_firstTeams[match] = other.m_firstTeams[i] + m_numTeams;
+        m_secondTeams[match] = other.m_secondTeams[i] + m_numTeams;
+        m_results[match] = other.m_results[i];
+        m_firstScores[match] = other.m_firstScores[i];
+        m_secondScores[match] = other.m_secondScores[i];
+        m_firstPrevious[match] = (other.m_firstPrevious[i] == NO_MATCH) ? NO_MATCH : other.m_firstPrevious[i] + m_size;
+        m_secondPrevious[match] = (other.m_secondPrevious[i] == NO_MATCH) ? NO_MATCH :
+                                                                             other.m_secondPrevious[i] + m_size;
+    }
+    for (int i = 0; i < other.m_numTeams; i++) {
+        m_teamIds[m_numTeams + i] = other.m_teamIds[i];
+    }
+    m_size += other.m_size;
+    m_numTeams += other.m_numTeams;
+}
+
+
+void MatchHistory::clear()
+{
+    for (int i = 0; i < m_pairCapacity; i++) {
+        m_pairKeys[i] = 0;
+    }
+    m_size = 0;
+    m_numTeams = 0;
+    m_numPairs = 0;
+    m_numIndexed = 0;
+}
+
+
+//-------------------------------------------Queries--------------------------------------------
+
+int MatchHistory::get_last_matches(const Team* team, const int numMatches, MatchRecord* matches) const
+{
+    int historyId = team->get_history_id();
+    int match = team->get_last_match();
+    int count = 0;
+    while (count < numMatches && match != NO_MATCH) {
+        MatchRecord& record = matches[count++];
+        if (m_firstTeams[match] == historyId) {
+            record.opponentId = m_teamIds[m_secondTeams[match]];
+            record.result = m_results[match];
+            record.score = m_firstScores[match];
+            record.opponentScore = m_secondScores[match];
+            match = m_firstPrevious[match];
+        }
+        else {
+            record.opponentId = m_teamIds[m_firstTeams[match]];
+            record.result = flip_result(m_results[match]);
+            record.score = m_secondScores[match];
+            record.opponentScore = m_firstScores[match];
+            match = m_secondPrevious[match];
+        }
+    }
+    return count;
+}
+
+
+HeadToHead MatchHistory::get_head_to_head(const Team* team1, const Team* team2)
+{
+    index_pairs();
+    HeadToHead record = {0, 0, 0};
+    int historyId1 = team1->get_history_id();
+    int historyId2 = team2->get_history_id();
+    int slot = find_pair(pair_key(historyId1, historyId2));
+    if (m_pairKeys[slot] == 0) {
+        return record;
+    }
+    record = m_pairRecords[slot];
+    //The table holds the record of the lower history ID
+    if (historyId1 > historyId2) {
+        int wins = record.wins;
+        record.wins = record.losses;
+        record.losses = wins;
+    }
+    return record;
+}
+
+
+int MatchHistory::get_size() const
+{
+    return m_size;
+}
+
+
+int MatchHistory::get_num_teams() const
+{
+    return m_numTeams;
+}
+
+
+//---------------------------------------Helper Functions---------------------------------------
+
+int MatchHistory::flip_result(const int result)
+{
+    if (result == 0) {
+        return 0;
+    }
+    return (result <= 2) ? result + 2 : result - 2;
+}
+
+
+long long MatchHistory::pair_key(const int historyId1, const int historyId2)
+{
+    long long low = (historyId1 < historyId2) ? historyId1 : historyId2;
+    long long high = (historyId1 < historyId2) ? historyId2 : historyId1;
+    return (low << 32) | high;
+}
+
+
+int MatchHistory::find_pair(const long long key) const
+{
+    unsigned long long hash = (unsigned long long)key * 0x9E3779B97F4A7C15ull;
+    int slot = (int)(hash >> 32) & (m_pairCapacity - 1);
+    while (m_pairKeys[slot] != 0 && m_pairKeys[slot] != key) {
+        slot = (slot + 1) & (m_pairCapacity - 1);
+    }
+    return slot;
+}
+
+
+void MatchHistory::index_pairs()
+{
+    while (m_numIndexed < m_size) {
+        int match = m_numIndexed;
+        long long key = pair_key(m_firstTeams[match], m_secondTeams[match]);
+        int slot = find_pair(key);
+        if (m_pairKeys[slot] == 0) {
+            //Keep the load factor under 1/2 (a failure leaves the match to the next search)
+            if (2 * (m_numPairs + 1) > m_pairCapacity) {
+                rehash_pairs(m_pairCapacity * 2);
+                slot = find_pair(key);
+            }
+            m_pairKeys[slot] = key;
+            m_pairRecords[slot].wins = 0;
+            m_pairRecords[slot].ties = 0;
+            m_pairRecords[slot].losses = 0;
+            m_numPairs++;
+        }
+        int result = m_results[match];
+        if (m_firstTeams[match] > m_secondTeams[match]) {
+            result = flip_result(result);
+        }
+        if (result == 0) {
+            m_pairRecords[slot].ties++;
+        }
+        else if (result <= 2) {
+            m_pairRecords[slot].wins++;
+        }
+        else {
+            m_pairRecords[slot].losses++;
+        }
+        m_numIndexed++;
+    }
+}
+
+
+void MatchHistory::enlarge(const int newCapacity)
+{
+    //Allocate all of the arrays before moving any of them, so that a failure leaves the log as it was
+    int* firstTeams = nullptr;
+    int* secondTeams = nullptr;
+    int* results = nullptr;
+    int* firstScores = nullptr;
+    int* secondScores = nullptr;
+    int* firstPrevious = nullptr;
+    int* secondPrevious = nullptr;
+    try {
+        firstTeams = new int[newCapacity];
+        secondTeams = new int[newCapacity];
+        results = new int[newCapacity];
+        firstScores = new int[newCapacity];
+        secondScores = new int[newCapacity];
+        firstPrevious = new int[newCapacity];
+        secondPrevious = new int[newCapacity];
+    }
+    catch (const std::bad_alloc& e) {
+        delete[] firstTeams;
+        delete[] secondTeams;
+        delete[] results;
+        delete[] firstScores;
+        delete[] secondScores;
+        delete[] firstPrevious;
+        throw e;
+    }
+    move_array(m_firstTeams, firstTeams, m_size);
+    move_array(m_secondTeams, secondTeams, m_size);
+    move_array(m_results, results, m_size);
+    move_array(m_firstScores, firstScores, m_size);
+    move_array(m_secondScores, secondScores, m_size);
+    move_array(m_firstPrevious, firstPrevious, m_size);
+    move_array(m_secondPrevious, secondPrevious, m_size);
+    m_capacity = newCapacity;
+}
+
+
+void MatchHistory::enlarge_teams(const int newCapacity)
+{
+    move_array(m_teamIds, new int[newCapacity], m_numTeams);
+    m_teamCapacity = newCapacity;
+}
+
+
+void MatchHistory::rehash_pairs(const int newCapacity)
+{
+    long long* newKeys = new long long[newCapacity];
+    HeadToHead* newRecords;
+    try {
+        newRecords = new HeadToHead[newCapacity];
+    }
+    catch (const std::bad_alloc& e) {
+        delete[] newKeys;
+        throw e;
+    }
+    for (int i = 0; i < newCapacity; i++) {
+        newKeys[i] = 0;
+    }
+    long long* oldKeys = m_pairKeys;
+    HeadToHead* oldRecords = m_pairRecords;
+    int oldCapacity = m_pairCapacity;
+    m_pairKeys = newKeys;
+    m_pairRecords = newRecords;
+    m_pairCapacity = newCapacity;
+    for (int i = 0; i < oldCapacity; i++) {
+        if (oldKeys[i] != 0) {
+            int slot = find_pair(oldKeys[i]);
+            m_pairKeys[slot] = oldKeys[i];
+            m_pairRecords[slot] = oldRecords[i];
+        }
+    }
+    delete[] oldKeys;
+    delete[] oldRecords;
+}
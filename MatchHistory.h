@@ -0,0 +1,248 @@
+#ifndef MATCHHISTORY_H
+#define MATCHHISTORY_H
+
+class Team;
+
+#include <new>
+
+/*
+* A match of a team, from the team's side: the opponent's ID, the result (the code play_match would return if the
+*       team was the first team: 0 for a tie, 1 or 2 for a win by score or by spirit, and 3 or 4 for a loss by score or
+*       by spirit), and the scores (points + ability) of the team and the opponent before the match
+*/
+struct MatchRecord {
+    int opponentId;
+    int result;
+    int score;
+    int opponentScore;
+};
+
+/*
+* The record of a team against another team: the number of matches the team won, tied and lost against it
+*/
+struct HeadToHead {
+    int wins;
+    int ties;
+    int losses;
+};
+
+/*
+* Class MatchHistory
+* This class is used to record every match that world_cup plays, in one log by the order of the matches.
+* The log is kept in columns (an array for every field of the matches), so recording a match is a few stores at the
+*       end of the arrays. Every match also keeps the previous match of each of its teams, and every team keeps its
+*       last match, so the matches of a team are a list from the newest to the oldest.
+* The teams are identified by a history ID that the log gives every team that is added, so the matches of a removed
+*       team are never mixed with the matches of a new team with the same ID.
+* The records of the pairs of teams (head to head) are kept in a hash table by the pair's history IDs, which is
+*       brought up to date from the log when it is searched, so recording a match does not search it.
+*/
+class MatchHistory {
+public:
+
+    /*
+    * NO_MATCH - the last match of a team that has not played, and the previous match of a team's first match
+    */
+    enum {
+        NO_MATCH = -1
+    };
+
+    /*
+    * Constructor of MatchHistory class
+    * @param - none
+    * @return - A new instance of MatchHistory, with no teams and no matches
+    */
+    MatchHistory();
+
+    /*
+    * Copy Constructor and Assignment Operator of MatchHistory class
+    * world_cup does not allow two of the same player or team (repeating ID's).
+    * Therefore the system does not allow a copy constructor or assignment operator.
+    */
+    MatchHistory(const MatchHistory& other) = delete;
+    MatchHistory& operator=(const MatchHistory& other) = delete;
+
+    /*
+    * Destructor of MatchHistory class
+    * @param - none
+    * @return - void
+    */
+    ~MatchHistory();
+
+    /*
+     * Give a new team its history ID
+     * @param - the ID of the team
+     * @return - the history ID of the team
+     */
+    int add_team(const int teamId);
+
+    /*
+     * Take back the history ID of the team that was added last (used when adding the team to world_cup failed after
+     *       add_team)
+     * @param - none
+     * @return - void
+     */
+    void remove_last_team();
+
+    /*
+     * Make room in the log for the given number of matches, so that recording them can't fail
+     * @param - the number of matches
+     * @return - void
+     */
+    void reserve(const int numMatches);
+
+    /*
+     * Make room for the given number of new teams, so that adding them can't fail
+     * @param - the number of teams
+     * @return - void
+     */
+    void reserve_teams(const int numTeams);
+
+    /*
+     * Add the teams and the matches of another log after the ones of this log (the log must already have room for
+     *       them, see reserve and reserve_teams). Their history IDs and matches are shifted by the number of teams
+     *       and matches this log had, and their head-to-head records are added to the table on the next search.
+     * @param - the other log
+     * @return - void
+     */
+    void append(const MatchHistory& other);
+
+    /*
+     * Remove all of the teams and the matches from the log (keeping its memory)
+     * @param - none
+     * @return - void
+     */
+    void clear();
+
+    /*
+     * Record a match at the end of the log, and make it the last match of both teams
+     * @param - the teams (in the order of play_match), the result play_match returned, and the scores of the teams
+     *          before the match
+     * @return - void
+     */
+    void record(Team* team1, Team* team2, const int result, const int score1, const int score2);
+
+    /*
+     * Add places for the given number of matches at the end of the log (which must already have room for them, see
+     *       reserve), to be recorded with record_at
+     * @param - the number of matches
+     * @return - the place of the first of the matches
+     */
+    int extend(const int numMatches);
+
+    /*
+     * Record a match at a place that extend added, and make it the last match of both teams. The matches of every
+     *       team must be recorded in the order of their places, and matches without a shared team may be recorded
+     *       at the same time.
+     * @param - the place of the match, the teams (in the order of play_match), the result play_match returned, and
+     *          the scores of the teams before the match
+     * @return - void
+     */
+    void record_at(const int match, Team* team1, Team* team2, const int result, const int score1, const int score2);
+
+    /*
+     * Write the last matches of a team, from the newest to the oldest
+     * @param - the team, the number of matches, and an array (of that number) that receives the matches
+     * @return - the number of matches written (fewer if the team played fewer matches)
+     */
+    int get_last_matches(const Team* team, const int numMatches, MatchRecord* matches) const;
+
+    /*
+     * Return the record of a team against another team (the head-to-head table is brought up to date first)
+     * @param - the two teams
+     * @return - the number of matches the first team won, tied and lost against the second team
+     */
+    HeadToHead get_head_to_head(const Team* team1, const Team* team2);
+
+    /*
+     * Return the number of matches in the log
+     * @param - none
+     * @return - the number of matches
+     */
+    int get_size() const;
+
+    /*
+     * Return the number of teams that were given a history ID
+     * @param - none
+     * @return - the number of teams
+     */
+    int get_num_teams() const;
+
+private:
+
+    /*
+     * Return the result of a match from the second team's side
+     * @param - the result from the first team's side
+     * @return - the result from the second team's side
+     */
+    static int flip_result(const int result);
+
+    /*
+     * Return the key of a pair of teams in the head-to-head table (the lower history ID in the high half)
+     * @param - the history IDs of the teams (different)
+     * @return - the key
+     */
+    static long long pair_key(const int historyId1, const int historyId2);
+
+    /*
+     * Return the slot of a key in the head-to-head table, or the empty slot where it should be inserted
+     * @param - the key
+     * @return - the slot
+     */
+    int find_pair(const long long key) const;
+
+    /*
+     * Add the matches that were recorded since the last search to the head-to-head table
+     * @return - void
+     */
+    void index_pairs();
+
+    /*
+     * Enlarge the arrays of the log to the given capacity, keeping the saved matches
+     * @return - void
+     */
+    void enlarge(const int newCapacity);
+
+    /*
+     * Enlarge the array of the teams to the given capacity, keeping the saved teams
+     * @return - void
+     */
+    void enlarge_teams(const int newCapacity);
+
+    /*
+     * Move the head-to-head table to a new table of the given capacity
+     * @return - void
+     */
+    void rehash_pairs(const int newCapacity);
+
+    /*
+     * The internal fields of MatchHistory:
+     *   The log, every array by the index of the match: the history IDs of the first and the second team, the result
+     *       (from the first team's side), the scores of the teams before the match, and the previous match of each of
+     *       the teams (NO_MATCH if there is none)
+     *   The number of matches, and the number of matches the arrays can hold
+     *   The ID of every team, by its history ID, the number of teams, and the number of teams the array can hold
+     *   The head-to-head table: the keys of the pairs (0 for an empty slot), the record of the lower history ID of the
+     *       pair against the higher one, the number of pairs, the number of slots (a power of 2), and the number of
+     *       matches of the log that were already added to it
+     */
+    int* m_firstTeams;
+    int* m_secondTeams;
+    int* m_results;
+    int* m_firstScores;
+    int* m_secondScores;
+    int* m_firstPrevious;
+    int* m_secondPrevious;
+    int m_size;
+    int m_capacity;
+    int* m_teamIds;
+    int m_numTeams;
+    int m_teamCapacity;
+    long long* m_pairKeys;
+    HeadToHead* m_pairRecords;
+    int m_numPairs;
+    int m_pairCapacity;
+    int m_numIndexed;
+};
+
+#endif //MATCHHISTORY_H
@@ -0,0 +1,570 @@
+#include "PlayerTable.h"
+#include "SpiritBatch.h"
+
+namespace {
+
+    /*
+     * Copy the first size elements of an array to a new one, and free the old array
+     */
+    template <class T>
+    void move_array(T*& array, T* newArray, const int size)
+    {
+        for (int i = 0; i < size; i++) {
+            newArray[i] = array[i];
+        }
+        delete[] array;
+        array = newArray;
+    }
+
+}
+
+//-------------------------------------------UnionFindStats-------------------------------------------
+
+void UnionFindStats::reset()
+{
+    for (int i = 0; i < NUM_BUCKETS; i++) {
+        findSteps[i] = 0;
+        unionSizes[i] = 0;
+    }
+    compressions = 0;
+    unions = 0;
+}
+
+
+int PlayerTable::s_nextEpoch = 0;
+
+//--------------------------------Constructor and Destructor------------------------------------
+
+PlayerTable::PlayerTable() :
+    m_parents(nullptr),
+    m_games(nullptr),
+    m_partialSpirits(nullptr),
+    m_teams(nullptr),
+    m_nextMembers(nullptr),
+    m_removed(nullptr),
+    m_ids(nullptr),
+    m_abilities(nullptr),
+    m_cards(nullptr),
+    m_goalkeepers(nullptr),
+    m_spirits(nullptr),
+    m_size(0),
+    m_capacity(0),
+    m_epoch(s_nextEpoch++)
+{
+    m_stats.reset();
+    enlarge(16);
+}
+
+
+PlayerTable::~PlayerTable()
+{
+    delete[] m_parents;
+    delete[] m_games;
+    delete[] m_partialSpirits;
+    delete[] m_teams;
+    delete[] m_nextMembers;
+    delete[] m_removed;
+    delete[] m_ids;
+    delete[] m_abilities;
+    delete[] m_cards;
+    delete[] m_goalkeepers;
+    delete[] m_spirits;
+}
+
+
+//----------------------------------------Add and Remove----------------------------------------
+
+int PlayerTable::add(const int playerId, const int gamesPlayed, const Spirit& partialSpirit, const int parent,
+                     const int ability, const int cards, const bool goalkeeper, const Spirit& spirit)
+{
+    if (m_size == m_capacity) {
+        enlarge(m_capacity * 2);
+    }
+    m_parents[m_size] = parent;
+    m_games[m_size] = gamesPlayed;
+    m_partialSpirits[m_size] = partialSpirit;
+    m_teams[m_size] = nullptr;
+    //A root starts a list of its own, and any other player is linked right after its parent
+    if (parent == NO_PLAYER) {
+        m_nextMembers[m_size] = m_size;
+    }
+    else {
+        m_nextMembers[m_size] = m_nextMembers[parent];
+        m_nextMembers[parent] = m_size;
+    }
+    //A new player is always added to an existing team
+    m_removed[m_size] = false;
+    m_ids[m_size] = playerId;
+    m_abilities[m_size] = ability;
+    m_cards[m_size] = cards;
+    m_goalkeepers[m_size] = goalkeeper;
+    m_spirits[m_size] = spirit;
+    return m_size++;
+}
+
+
+void PlayerTable::remove_last()
+{
+    m_size--;
+    //Unlink the player from its parent's list of members
+    if (m_parents[m_size] != NO_PLAYER) {
+        m_nextMembers[m_parents[m_size]] = m_nextMembers[m_size];
+    }
+}
+
+
+void PlayerTable::reserve(const int numPlayers)
+{
+    int newCapacity = m_capacity;
+    while (newCapacity < numPlayers) {
+        newCapacity *= 2;
+    }
+    if (newCapacity != m_capacity) {
+        enlarge(newCapacity);
+    }
+}
+
+
+void PlayerTable::append(const PlayerTable& other)
+{
+    int offset = m_size;
+    for (int i = 0; i < other.m_size; i++) {
+        int index = offset + i;
+        m_parents[index] = (other.m_parents[i] == NO_PLAYER) ? NO_PLAYER : other.m_parents[i] + offset;
+        m_games[index] = other.m_games[i];
+        m_partialSpirits[index] = other.m_partialSpirits[i];
+        m_teams[index] = nullptr;
+        m_nextMembers[index] = other.m_nextMembers[i] + offset;
+        m_removed[index] = true;
+        m_ids[index] = other.m_ids[i];
+        m_abilities[index] = other.m_abilities[i];
+        m_cards[index] = other.m_cards[i];
+        m_goalkeepers[index] = other.m_goalkeepers[i];
+        m_spirits[index] = other.m_spirits[i];
+    }
+    m_size += other.m_size;
+    //Only the members of the trees whose root still has a team are in a team
+    for (int i = 0; i < other.m_size; i++) {
+        if (other.m_parents[i] == NO_PLAYER && other.m_teams[i] != nullptr) {
+            int root = offset + i;
+            int member = root;
+            do {
+                m_removed[member] = false;
+                member = m_nextMembers[member];
+            } while (member != root);
+        }
+    }
+}
+
+
+void PlayerTable::clear()
+{
+    //The indices are given to new players, so the table takes a new epoch
+    m_size = 0;
+    m_epoch = s_nextEpoch++;
+}
+
+
+//-------------------------------------------Getters--------------------------------------------
+
+int PlayerTable::get_size() const
+{
+    return m_size;
+}
+
+
+int PlayerTable::get_epoch() const
+{
+    return m_epoch;
+}
+
+
+int PlayerTable::get_parent(const int index) const
+{
+    return m_parents[index];
+}
+
+
+int PlayerTable::get_gamesPlayed(const int index) const
+{
+    return m_games[index];
+}
+
+
+Spirit PlayerTable::get_partialSpirit(const int index) const
+{
+    return m_partialSpirits[index];
+}
+
+
+Team* PlayerTable::get_team(const int index) const
+{
+    return m_teams[index];
+}
+
+
+int PlayerTable::get_next_member(const int index) const
+{
+    return m_nextMembers[index];
+}
+
+
+int PlayerTable::get_playerId(const int index) const
+{
+    return m_ids[index];
+}
+
+
+int PlayerTable::get_ability(const int index) const
+{
+    return m_abilities[index];
+}
+
+
+int PlayerTable::get_cards(const int index) const
+{
+    return m_cards[index];
+}
+
+
+bool PlayerTable::get_goalkeeper(const int index) const
+{
+    return m_goalkeepers[index];
+}
+
+
+Spirit PlayerTable::get_spirit(const int index) const
+{
+    return m_spirits[index];
+}
+
+
+//-------------------------------------------Setters--------------------------------------------
+
+void PlayerTable::update_gamesPlayed(const int index, const int gamesPlayed)
+{
+    m_games[index] += gamesPlayed;
+}
+
+
+void PlayerTable::update_team(const int index, Team* team)
+{
+    m_teams[index] = team;
+}
+
+
+void PlayerTable::update_cards(const int index, const int cardsReceived)
+{
+    m_cards[index] += cardsReceived;
+}
+
+
+//-------------------------------------------Liveness-------------------------------------------
+
+void PlayerTable::detach(const int root)
+{
+    m_teams[root] = nullptr;
+}
+
+
+void PlayerTable::detach_all(const int* roots, const int numRoots)
+{
+    for (int i = 0; i < numRoots; i++) {
+        m_teams[roots[i]] = nullptr;
+    }
+}
+
+
+Team* PlayerTable::find_team(const int index, const FindPolicy policy)
+{
+    //A removed team's players never join another team
+    if (m_removed[index]) {
+        return nullptr;
+    }
+    int games;
+    Spirit spirit;
+    int root = find(index, games, spirit, policy);
+    if (m_teams[root] == nullptr) {
+        m_removed[index] = true;
+    }
+    return m_teams[root];
+}
+
+
+//------------------------------------------Union Find------------------------------------------
+
+int PlayerTable::find(const int index, int& games, Spirit& spirit, const FindPolicy policy)
+{
+    //The player is the root, or already points to it: there is nothing to shorten
+    int parent = m_parents[index];
+    if (parent == NO_PLAYER) {
+        count_find(0);
+        games = 0;
+        spirit = Spirit::neutral();
+        return index;
+    }
+    if (m_parents[parent] == NO_PLAYER) {
+        count_find(1);
+        games = m_games[index];
+        spirit = m_partialSpirits[index];
+        return parent;
+    }
+    games = 0;
+    spirit = Spirit::neutral();
+    int current = index;
+    int steps = 0;
+    if (policy == FindPolicy::FULL_COMPRESSION) {
+        //First pass: sum the games and multiply the partial spirits on the way up, not including the root
+        while (m_parents[current] != NO_PLAYER) {
+            games += m_games[current];
+            spirit = m_partialSpirits[current] * spirit;
+            current = m_parents[current];
+            steps++;
+        }
+        count_find(steps);
+        //Every player on the path except for the last one is pointed to the root
+        m_stats.compressions += steps - 1;
+        int root = current;
+        //Second pass: every player gets the totals from itself up to the root, and then its own share is removed
+        int remainingGames = games;
+        Spirit remainingSpirit = spirit;
+        current = index;
+        //The last player of the path already points to the root
+        while (m_parents[current] != root) {
+            int next = m_parents[current];
+            int ownGames = m_games[current];
+            Spirit ownSpirit = m_partialSpirits[current];
+            m_games[current] = remainingGames;
+            m_partialSpirits[current] = remainingSpirit;
+            m_parents[current] = root;
+            remainingGames -= ownGames;
+            remainingSpirit = remainingSpirit * ownSpirit.inv();
+            current = next;
+        }
+        return root;
+    }
+    while (m_parents[current] != NO_PLAYER) {
+        parent = m_parents[current];
+        steps++;
+        if (policy == FindPolicy::PATH_SPLITTING) {
+            games += m_games[current];
+            spirit = m_partialSpirits[current] * spirit;
+        }
+        //Skip the parent: the player's games and partial spirit become relative to its grandparent
+        bool skipped = m_parents[parent] != NO_PLAYER;
+        if (skipped) {
+            m_games[current] += m_games[parent];
+            m_partialSpirits[current] = m_partialSpirits[parent] * m_partialSpirits[current];
+            m_parents[current] = m_parents[parent];
+            m_stats.compressions++;
+        }
+        if (policy == FindPolicy::PATH_HALVING) {
+            //The walk also followed the parent's link, which the player now skips
+            if (skipped) {
+                steps++;
+            }
+            //Continue from the grandparent, with the player's combined games and partial spirit
+            games += m_games[current];
+            spirit = m_partialSpirits[current] * spirit;
+            current = m_parents[current];
+        }
+        else {
+            current = parent;
+        }
+    }
+    count_find(steps);
+    return current;
+}
+
+
+int PlayerTable::players_union(const int root, const int otherRoot, const int currentNumPlayers,
+                               const int otherNumPlayers, const Spirit& currentTeamSpirit,
+                               const Spirit& otherTeamSpirit)
+{
+    //Nothing to unite!
+    if (currentNumPlayers == 0 || otherNumPlayers == 0) {
+        return NO_PLAYER;
+    }
+    //Count the union by the size of its smaller tree
+    count_union((currentNumPlayers < otherNumPlayers) ? currentNumPlayers : otherNumPlayers);
+    //Splice the two circular lists of members into one
+    int next = m_nextMembers[root];
+    m_nextMembers[root] = m_nextMembers[otherRoot];
+    m_nextMembers[otherRoot] = next;
+    //Other team is smaller - they will be joining the current team's upside down tree
+    if (currentNumPlayers >= otherNumPlayers) {
+        //Change root of other team to current team's root
+        m_parents[otherRoot] = root;
+        m_teams[otherRoot] = nullptr;
+        //Update partial spirit for team
+        m_partialSpirits[otherRoot] = currentTeamSpirit * m_partialSpirits[otherRoot];
+        m_partialSpirits[otherRoot] = m_partialSpirits[root].inv() * m_partialSpirits[otherRoot];
+        //Update games played of other team
+        m_games[otherRoot] -= m_games[root];
+        //Return root of new player upside-down tree
+        return root;
+    }
+    //Change root of current team to other team's root
+    m_parents[root] = otherRoot;
+    m_teams[root] = nullptr;
+    //Update partial spirit for team
+    m_partialSpirits[otherRoot] = currentTeamSpirit * m_partialSpirits[otherRoot];
+    m_partialSpirits[root] = m_partialSpirits[otherRoot].inv() * m_partialSpirits[root];
+    //Update games played of current team
+    m_games[root] -= m_games[otherRoot];
+    //Return root of new player upside-down tree
+    return otherRoot;
+}
+
+
+int PlayerTable::players_union_all(const int* roots, const int* numPlayers, const Spirit* teamSpirits,
+                                   const int numTrees, unsigned char* packed)
+{
+    //The largest tree keeps its root
+    int largest = 0;
+    for (int i = 1; i < numTrees; i++) {
+        if (numPlayers[i] > numPlayers[largest]) {
+            largest = i;
+        }
+    }
+    int newRoot = roots[largest];
+    //The spirit of every root in the united team is the product of the spirits of the teams before it, and then its
+    //own. The new root keeps it, and every other root is relative to the new root, so its own spirit is multiplied
+    //by the inverse of the new root's spirit and then by the product before it.
+    Spirit prefix = Spirit::neutral();
+    for (int i = 0; i < largest; i++) {
+        prefix = prefix * teamSpirits[i];
+    }
+    Spirit newRootInverse = (prefix * m_partialSpirits[newRoot]).inv();
+    //The products are serial, but the compositions with the roots' own spirits are done at once, on the packed forms
+    const int N = permutation_t::N;
+    unsigned char* productsPacked = packed;
+    unsigned char* rootsPacked = packed + numTrees * N;
+    unsigned char* composedPacked = packed + 2 * numTrees * N;
+    prefix = Spirit::neutral();
+    for (int i = 0; i < numTrees; i++) {
+        Spirit product = (i == largest) ? prefix : newRootInverse * prefix;
+        product.to_packed(productsPacked + i * N);
+        m_partialSpirits[roots[i]].to_packed(rootsPacked + i * N);
+        prefix = prefix * teamSpirits[i];
+    }
+    compose_packed(productsPacked, rootsPacked, composedPacked, numTrees);
+    for (int i = 0; i < numTrees; i++) {
+        m_partialSpirits[roots[i]] = Spirit::from_packed(composedPacked + i * N);
+    }
+    //Every other root joins the largest tree directly under its root
+    for (int i = 0; i < numTrees; i++) {
+        int root = roots[i];
+        if (root == newRoot) {
+            continue;
+        }
+        count_union(numPlayers[i]);
+        int next = m_nextMembers[newRoot];
+        m_nextMembers[newRoot] = m_nextMembers[root];
+        m_nextMembers[root] = next;
+        m_parents[root] = newRoot;
+        m_teams[root] = nullptr;
+        m_games[root] -= m_games[newRoot];
+    }
+    return newRoot;
+}
+
+
+int PlayerTable::export_members(const int root, int* playerIds, int* games, Spirit* spirits)
+{
+    int numMembers = 0;
+    int current = root;
+    do {
+        playerIds[numMembers] = m_ids[current];
+        find(current, games[numMembers], spirits[numMembers], FindPolicy::FULL_COMPRESSION);
+        numMembers++;
+        current = m_nextMembers[current];
+    } while (current != root);
+    return numMembers;
+}
+
+
+const UnionFindStats& PlayerTable::get_stats() const
+{
+    return m_stats;
+}
+
+
+void PlayerTable::reset_stats()
+{
+    m_stats.reset();
+}
+
+
+//---------------------------------------Helper Functions---------------------------------------
+
+void PlayerTable::count_find(const int steps)
+{
+    m_stats.findSteps[(steps < UnionFindStats::NUM_BUCKETS) ? steps : UnionFindStats::NUM_BUCKETS - 1]++;
+}
+
+
+void PlayerTable::count_union(const int smaller)
+{
+    int bucket = 0;
+    for (int size = smaller; size > 1 && bucket < UnionFindStats::NUM_BUCKETS - 1; size /= 2) {
+        bucket++;
+    }
+    m_stats.unions++;
+    m_stats.unionSizes[bucket]++;
+}
+
+
+void PlayerTable::enlarge(const int newCapacity)
+{
+    //Allocate all of the arrays before moving any of them, so that a failure leaves the table as it was
+    int* parents = nullptr;
+    int* games = nullptr;
+    Spirit* partialSpirits = nullptr;
+    Team** teams = nullptr;
+    int* nextMembers = nullptr;
+    bool* removed = nullptr;
+    int* ids = nullptr;
+    int* abilities = nullptr;
+    int* cards = nullptr;
+    bool* goalkeepers = nullptr;
+    Spirit* spirits = nullptr;
+    try {
+        parents = new int[newCapacity];
+        games = new int[newCapacity];
+        partialSpirits = new Spirit[newCapacity];
+        teams = new Team*[newCapacity];
+        nextMembers = new int[newCapacity];
+        removed = new bool[newCapacity];
+        ids = new int[newCapacity];
+        abilities = new int[newCapacity];
+        cards = new int[newCapacity];
+        goalkeepers = new bool[newCapacity];
+        spirits = new Spirit[newCapacity];
+    }
+    catch (const std::bad_alloc& e) {
+        delete[] parents;
+        delete[] games;
+        delete[] partialSpirits;
+        delete[] teams;
+        delete[] nextMembers;
+        delete[] removed;
+        delete[] ids;
+        delete[] abilities;
+        delete[] cards;
+        delete[] goalkeepers;
+        throw e;
+    }
+    move_array(m_parents, parents, m_size);
+    move_array(m_games, games, m_size);
+    move_array(m_partialSpirits, partialSpirits, m_size);
+    move_array(m_teams, teams, m_size);
+    move_array(m_nextMembers, nextMembers, m_size);
+    move_array(m_removed, removed, m_size);
+    move_array(m_ids, ids, m_size);
+    move_array(m_abilities, abilities, m_size);
+    move_array(m_cards, cards, m_size);
+    move_array(m_goalkeepers, goalkeepers, m_size);
+    move_array(m_spirits, spirits, m_size);
+    m_capacity = newCapacity;
+}
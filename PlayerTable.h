@@ -0,0 +1,333 @@
+#ifndef PLAYERTABLE_H
+#define PLAYERTABLE_H
+
+class Team;
+
+#include <new>
+#include "Spirit.h"
+
+/*
+* The ways in which PlayerTable::find shortens the path from a player to the root:
+*   FULL_COMPRESSION - every player on the path points to the root (two passes over the path)
+*   PATH_HALVING - every other player on the path points to its grandparent (a single pass)
+*   PATH_SPLITTING - every player on the path points to its grandparent (a single pass)
+*/
+enum struct FindPolicy {
+    FULL_COMPRESSION,
+    PATH_HALVING,
+    PATH_SPLITTING
+};
+
+/*
+* Counters of the union-find of PlayerTable, for checking how long the paths get in practice
+*/
+struct UnionFindStats {
+    enum {
+        NUM_BUCKETS = 32
+    };
+
+    /*
+    * Set all of the counters to 0
+    * @return - void
+    */
+    void reset();
+
+    /*
+     * The counters:
+     *   findSteps[d] - the number of finds that followed d parent links (the last bucket also counts longer walks)
+     *   The number of parent links that were changed by finds (path compression)
+     *   The number of unions of two non-empty trees
+     *   unionSizes[b] - the number of unions whose smaller tree had [2^b, 2^(b+1)) players
+     */
+    long long findSteps[NUM_BUCKETS];
+    long long compressions;
+    long long unions;
+    long long unionSizes[NUM_BUCKETS];
+};
+
+/*
+* The details of a new player, for adding several players to a team at once (the same as the parameters of
+*       world_cup's add_player)
+*/
+struct PlayerSpec {
+    int playerId;
+    permutation_t spirit;
+    int gamesPlayed;
+    int ability;
+    int cards;
+    bool goalKeeper;
+};
+
+/*
+* Class PlayerTable
+* This class is used to hold all of the players in the world_cup system.
+* Every player gets a dense index when it is added (0, 1, 2, ...), and every field of the player is saved in its own
+*       array under that index. The players of a team form an upside-down tree (union-find), where every player
+*       points to the index of its parent:
+*   - the fields that find walks (parent, games and partial spirit relative to the parent, and the team of a root)
+*       are kept in arrays of their own, so a path is walked over contiguous memory
+*   - the attributes that are written in add_player and then rarely read (ID, ability, cards, whether the player is
+*       a goalkeeper, and the player's own spirit) are kept apart from them
+* The players are never removed (a player of a removed team stays, without a team), so the arrays only grow.
+* Every table has an epoch that no other table (and no earlier state of the same table, before clear) has, so the
+*       handles of world_cup can tell the tables apart.
+* Liveness: a team is only removed through detach, and its players never join another team. Every player remembers
+*       once a find showed that its team was removed, so the later finds of the player are skipped.
+* Rosters: the players of every upside-down tree are also linked in a circular list (every player points to the next
+*       member of its tree), so a team's players can be listed without scanning the whole table. Uniting two trees
+*       splices their lists in O(1).
+*/
+class PlayerTable {
+public:
+
+    /*
+    * NO_PLAYER - the index of "no player": the parent of a root, or the root of a team without players
+    */
+    enum {
+        NO_PLAYER = -1
+    };
+
+    /*
+    * Constructor of PlayerTable class
+    * @param - none
+    * @return - A new instance of PlayerTable, with no players
+    */
+    PlayerTable();
+
+    /*
+    * Copy Constructor and Assignment Operator of PlayerTable class
+    * world_cup does not allow two of the same player or team (repeating ID's).
+    * Therefore the system does not allow a copy constructor or assignment operator.
+    */
+    PlayerTable(const PlayerTable& other) = delete;
+    PlayerTable& operator=(const PlayerTable& other) = delete;
+
+    /*
+    * Destructor of PlayerTable class
+    * @param - none
+    * @return - void
+    */
+    ~PlayerTable();
+
+    /*
+     * Add a new player (a player with a parent joins its parent's list of members)
+     * @param - the player's ID, its games and partial spirit relative to its parent, the index of its parent
+     *          (NO_PLAYER for a root, or the root of the player's tree), and its ability, cards, whether it is a
+     *          goalkeeper and its spirit
+     * @return - the index of the new player
+     */
+    int add(const int playerId, const int gamesPlayed, const Spirit& partialSpirit, const int parent,
+            const int ability, const int cards, const bool goalkeeper, const Spirit& spirit);
+
+    /*
+     * Remove the player that was added last (used when adding the player to world_cup failed after add)
+     * @param - none
+     * @return - void
+     */
+    void remove_last();
+
+    /*
+     * Make sure the table can hold the given number of players without being enlarged again
+     * @param - the expected number of players
+     * @return - void
+     */
+    void reserve(const int numPlayers);
+
+    /*
+     * Add all of the players of another table after the players of this table (the table must already have room for
+     *       them), keeping their trees and lists of members. The roots are added without their teams (update_team),
+     *       and the players that were in a removed team stay out of any team.
+     * @param - the other table
+     * @return - void
+     */
+    void append(const PlayerTable& other);
+
+    /*
+     * Remove all of the players from the table (keeping its memory), and take a new epoch
+     * @param - none
+     * @return - void
+     */
+    void clear();
+
+    /*
+     * Return the number of players in the table
+     * @param - none
+     * @return - the number of players
+     */
+    int get_size() const;
+
+    /*
+     * Return the epoch of the table
+     * @param - none
+     * @return - the epoch
+     */
+    int get_epoch() const;
+
+    /*
+     * Getters of the union-find fields of the player with the given index
+     */
+    int get_parent(const int index) const;
+    int get_gamesPlayed(const int index) const;
+    Spirit get_partialSpirit(const int index) const;
+    Team* get_team(const int index) const;
+    int get_next_member(const int index) const;
+
+    /*
+     * Getters of the attributes of the player with the given index
+     */
+    int get_playerId(const int index) const;
+    int get_ability(const int index) const;
+    int get_cards(const int index) const;
+    bool get_goalkeeper(const int index) const;
+    Spirit get_spirit(const int index) const;
+
+    /*
+     * Update the number of games the player with the given index played (relative to its parent)
+     * @param - the index of the player and the number of new games
+     * @return - void
+     */
+    void update_gamesPlayed(const int index, const int gamesPlayed);
+
+    /*
+     * Update the team of the player with the given index (only the roots hold their team, nullptr after the team
+     *       was removed)
+     * @param - the index of the player and a pointer to the team
+     * @return - void
+     */
+    void update_team(const int index, Team* team);
+
+    /*
+     * Detach the team from the players of the given root, after the team was removed from world_cup
+     * @param - the index of the root of the removed team's players
+     * @return - void
+     */
+    void detach(const int root);
+
+    /*
+     * Detach the teams from the players of the given roots, after the teams were removed from world_cup together
+     * @param - the indices of the roots of the removed teams' players, and their number
+     * @return - void
+     */
+    void detach_all(const int* roots, const int numRoots);
+
+    /*
+     * Return the team of the player with the given index, with a single find (for the updates that need the team
+     *       anyway). A player whose team was removed is known without a find.
+     * @param - the index of the player and the policy of the find
+     * @return - a pointer to the player's team, or nullptr if its team was removed
+     */
+    Team* find_team(const int index, const FindPolicy policy);
+
+    /*
+     * Update the number of cards the player with the given index received
+     * @param - the index of the player and the number of new cards
+     * @return - void
+     */
+    void update_cards(const int index, const int cardsReceived);
+
+    /*
+    * Find the root of the player's upside-down tree, and shorten the path to it according to the policy.
+    *       Every player on the path keeps its games and partial spirit relative to its (new) parent.
+    * @param - the index of the player, references that receive the games and partial spirit of the player relative
+    *          to the root (the sum / product over the path, not including the root), and the policy
+    * @return - the index of the root player of the upside-down tree.
+    */
+    int find(const int index, int& games, Spirit& spirit, const FindPolicy policy);
+
+    /*
+    * Helper function for buy_team in world_cup:
+    * Unite between the two team players, by the size of the teams, and splice their lists of members.
+    * @param - the roots of the buying and bought teams, their number of players and their spirits
+    * @return - the index of the root of the new player upside down tree.
+    */
+    int players_union(const int root, const int otherRoot, const int currentNumPlayers, const int otherNumPlayers,
+                      const Spirit& currentTeamSpirit, const Spirit& otherTeamSpirit);
+
+    /*
+    * Helper function for buy_teams in world_cup:
+    * Unite the players of several teams in one pass: the largest tree keeps its root, and the root of every other tree
+    *       is attached directly under it (which keeps the depth of the union by size). The players keep the games
+    *       and spirits they would have after buying the teams one by one, in the given order (the roots' spirits are
+    *       composed at once with compose_packed).
+    * @param - the roots of the (non-empty) trees in the order of the buys (the buyer first), their number of players,
+    *          the spirits of their teams, the number of trees, and a buffer of 3 * numTrees * N bytes for the packed
+    *          spirits (allocated by the caller, so that the union can't fail halfway)
+    * @return - the index of the root of the new player upside down tree.
+    */
+    int players_union_all(const int* roots, const int* numPlayers, const Spirit* teamSpirits, const int numTrees,
+                          unsigned char* packed);
+
+    /*
+    * Export every member of the given root's tree, in the order of the list of members.
+    *       Every member's path is compressed with FULL_COMPRESSION on the way, so a path prefix that several members
+    *       share is only walked by the first of them, and the whole tree is exported in O(number of members).
+    * @param - the root, and buffers (with room for every member) that receive the ID of every member and its games
+    *          and partial spirit relative to the root (not including the root's own values)
+    * @return - the number of members
+    */
+    int export_members(const int root, int* playerIds, int* games, Spirit* spirits);
+
+    /*
+    * Return the counters of the union-find since the table was created (or since reset_stats)
+    * @return - the counters
+    */
+    const UnionFindStats& get_stats() const;
+
+    /*
+    * Set the counters of the union-find to 0
+    * @return - void
+    */
+    void reset_stats();
+
+private:
+
+    /*
+    * Count a find that followed the given number of parent links
+    * @return - void
+    */
+    void count_find(const int steps);
+
+    /*
+    * Count a union whose smaller tree has the given number of players
+    * @return - void
+    */
+    void count_union(const int smaller);
+
+    /*
+    * Enlarge the arrays to the given capacity, keeping the saved players
+    * @return - void
+    */
+    void enlarge(const int newCapacity);
+
+    /*
+     * The internal fields of PlayerTable, every array by the index of the player:
+     *   The index of the player's parent (NO_PLAYER for a root)
+     *   The number of games the player has played, relative to its parent
+     *   The player's partial spirit, relative to its parent
+     *   The team of a root player (nullptr for other players, and for the players of a removed team)
+     *   The next member of the player's tree, in the circular list of the tree's members
+     *   Whether a find already showed that the player's team was removed
+     *   The player's ID, ability, number of cards, whether it is a goalkeeper, and its spirit
+     *   The number of players, and the number of players the arrays can hold
+     *   The epoch of the table
+     * The epoch of the next table that is created
+     */
+    int* m_parents;
+    int* m_games;
+    Spirit* m_partialSpirits;
+    Team** m_teams;
+    int* m_nextMembers;
+    bool* m_removed;
+    int* m_ids;
+    int* m_abilities;
+    int* m_cards;
+    bool* m_goalkeepers;
+    Spirit* m_spirits;
+    int m_size;
+    int m_capacity;
+    int m_epoch;
+    static int s_nextEpoch;
+    UnionFindStats m_stats;
+};
+
+#endif //PLAYERTABLE_H
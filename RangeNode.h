@@ -0,0 +1,97 @@
+#ifndef RANGENODE_H
+#define RANGENODE_H
+
+#include "GenericNode.h"
+
+/*
+* Class RangeNode : GenericNode
+* This class is used to create the separate nodes of a RangeTree - an AVL tree sorted by ID, in which every node
+*       also counts the number of valid data (for teams: teams with a goalkeeper) in its subtree.
+* The links, the rotations and the height are those of GenericNode, which calls update_counts for the nodes whose
+*       subtrees a rotation changes.
+*/
+template <class T>
+class RangeNode : public GenericNode<T, RangeNode<T>> {
+public:
+
+    /*
+    * Constructor of RangeNode class
+    * @param - none
+    * @return - A new instance of RangeNode
+    */
+    RangeNode();
+
+    /*
+    * Copy Constructor and Assignment Operator of RangeNode class
+    * world_cup does not allow two of the same player or team (repeating ID's).
+    * Therefore the system does not allow a copy constructor or assignment operator.
+    */
+    RangeNode(const RangeNode&) = delete;
+    RangeNode& operator=(const RangeNode& other) = delete;
+
+    /*
+    * Destructor of RangeNode class
+    * @param - none
+    * @return - void
+    */
+    ~RangeNode() = default;
+
+private:
+
+    /*
+     * Update the number of valid data in the subtree of the current node
+     * @param - none
+     * @return - void
+    */
+    void update_counts();
+
+    /*
+     * The internal fields of RangeNode:
+     *   Whether the data of the node is valid
+     *   The number of nodes with valid data in the node's subtree
+     */
+    bool m_isValid;
+    int m_numValid;
+
+    /*
+     * The following classes are friend classes in order to allow full access to private fields and functions of
+     * RangeNode, allowing RangeNode to be a mostly private class, while allowing the system to run smoothly.
+    */
+    friend class GenericNode<T, RangeNode<T>>;
+
+    template <class M>
+    friend class RangeTree;
+
+    template <class N, class M>
+    friend class Tree;
+
+};
+
+//--------------------------------------------Constructor---------------------------------------------------
+
+template <class T>
+RangeNode<T>::RangeNode() :
+        GenericNode<T, RangeNode<T>>(),
+        m_isValid(false),
+        m_numValid(0)
+{}
+
+
+//----------------------------------------------Node Stats---------------------------------------------------
+
+//Update the number of valid data in the subtree of the specific node
+template <class T>
+void RangeNode<T>::update_counts()
+{
+    int left = 0;
+    int right = 0;
+    if (this->m_left != nullptr) {
+        left = this->m_left->m_numValid;
+    }
+    if (this->m_right != nullptr) {
+        right = this->m_right->m_numValid;
+    }
+    m_numValid = left + right + (m_isValid ? 1 : 0);
+}
+
+#endif //RANGENODE_H
@@ -0,0 +1,240 @@
+#ifndef RANGETREE_H
+#define RANGETREE_H
+
+#include "AVLTree.h"
+#include "RangeNode.h"
+#include "Exception.h"
+
+/*
+* Class RangeTree : Tree
+* This class is used to create an AVL tree based on RangeNode that is sorted by ID, and counts the valid data
+*       (data->is_valid()) in every subtree, so that the valid data in an ID range can be found without visiting
+*       the invalid data.
+*/
+template <class T>
+class RangeTree : public Tree<RangeNode<T>, T> {
+public:
+
+    /*
+    * Constructor of RangeTree class
+    * @param - none
+    * @return - A new instance of RangeTree
+    */
+    RangeTree();
+
+    /*
+    * Copy Constructor and Assignment Operator of RangeTree class
+    * world_cup does not allow two of the same player or team (repeating ID's).
+    * Therefore the system does not allow a copy constructor or assignment operator.
+    */
+    RangeTree(const RangeTree& other) = delete;
+    RangeTree& operator=(const RangeTree& other) = delete;
+
+    /*
+    * Destructor of RangeTree class
+    * @param - none
+    * @return - void
+    */
+    ~RangeTree() = default;
+
+    /*
+     * Insert new node with data, according to the id given
+     * @param - New data to insert and the ID of the new node
+     * @return - void
+     */
+    void insert(T data, const int id);
+
+    /*
+     * Remove node according to the id given
+     * @param - The ID of the node that needs to be removed
+     * @return - void
+     */
+    void remove(const int id);
+
+    /*
+     * Re-check whether the data of a node is valid, after the data has changed
+     * @param - The ID of the node
+     * @return - void
+     */
+    void update_valid(const int id);
+
+    /*
+     * Count the valid data with an ID in the range given
+     * @param - The lowest and highest IDs of the range (inclusive)
+     * @return - the number of valid data in the range
+     */
+    int count_valid(const int minId, const int maxId) const;
+
+    /*
+     * Insert the valid data with an ID in the range given into an array, sorted by ID
+     * @param - The lowest and highest IDs of the range (inclusive), and an array of size count_valid(minId, maxId)
+     * @return - the number of data inserted into the array
+     */
+    int get_valid_in_range(const int minId, const int maxId, T* const array) const;
+
+private:
+
+    /*
+     * Count the valid data with an ID that is lower than (or equal to, if inclusive) the given ID
+     * @param - The ID and whether the ID itself is counted
+     * @return - the number of valid data
+     */
+    int count_valid_below(const int id, const bool inclusive) const;
+
+    /*
+     * Helper function for get_valid_in_range:
+     * Recursively insert the valid data of the subtree that is in the range into the array.
+     * Subtrees without valid data are skipped.
+     * @param - the current node, the range, the array and the current index in the array
+     * @return - current index in the array
+     */
+    int get_valid_recursively(const RangeNode<T>* node, const int minId, const int maxId, T* const array,
+                              int index) const;
+
+    /*
+     * Go up the tree and update the number of valid data in every subtree on the way
+     * @param - The node from which the update needs to start
+     * @return - void
+     */
+    void upwardUpdate(RangeNode<T>* starting);
+
+    /*
+     * Helper function for remove_if:
+     * Update the number of valid data in the subtree of a node that was linked into the rebuilt tree
+     * @param - The node
+     * @return - void
+     */
+    void update_counts(RangeNode<T>* node) override;
+};
+
+
+//-----------------------------------------Constructor--------------------------
+
+template<class T>
+RangeTree<T>::RangeTree() :
+    Tree<RangeNode<T>, T>()
+{}
+
+
+//----------------------------------Insert and Remove---------------------------------
+
+template<class T>
+void RangeTree<T>::insert(T data, const int id) {
+    Tree<RangeNode<T>, T>::insert(data, id);
+    //The rotations already fixed every subtree that does not hold the new node, so only its path needs an update
+    RangeNode<T>* node = &(this->search_specific_id(id));
+    node->m_isValid = data->is_valid();
+    upwardUpdate(node);
+}
+
+
+template<class T>
+void RangeTree<T>::remove(const int id) {
+    if (this->m_node->m_id == id && this->m_node->m_right == nullptr && this->m_node->m_left == nullptr
+                                                                                && this->m_node->m_parent == nullptr) {
+        Tree<RangeNode<T>, T>::remove(id);
+        this->m_node->m_isValid = false;
+        this->m_node->m_numValid = 0;
+        return;
+    }
+    RangeNode<T>* toRemove = &(this->search_specific_id(id));
+    RangeNode<T>* nodeToFix = this->make_node_leaf(toRemove);
+    delete toRemove;
+    //Fix the counts before rebalancing, since the rotations recompute the counts from the children
+    upwardUpdate(nodeToFix);
+    this->rebalance_tree(nodeToFix);
+}
+
+
+template<class T>
+void RangeTree<T>::update_valid(const int id) {
+    RangeNode<T>* node = &(this->search_specific_id(id));
+    bool isValid = node->m_data->is_valid();
+    if (isValid != node->m_isValid) {
+        node->m_isValid = isValid;
+        upwardUpdate(node);
+    }
+}
+
+
+//-----------------------------------------Range Functions-----------------------------------------
+
+template<class T>
+int RangeTree<T>::count_valid(const int minId, const int maxId) const {
+    if (minId > maxId || this->m_node->m_height < 0) {
+        return 0;
+    }
+    return count_valid_below(maxId, true) - count_valid_below(minId, false);
+}
+
+
+template<class T>
+int RangeTree<T>::get_valid_in_range(const int minId, const int maxId, T* const array) const {
+    if (minId > maxId || this->m_node->m_height < 0) {
+        return 0;
+    }
+    return get_valid_recursively(this->m_node, minId, maxId, array, 0);
+}
+
+
+template<class T>
+int RangeTree<T>::count_valid_below(const int id, const bool inclusive) const {
+    int count = 0;
+    const RangeNode<T>* node = this->m_node;
+    while (node != nullptr) {
+        if (node->m_id < id || (inclusive && node->m_id == id)) {
+            //The node and its whole left subtree are below the ID
+            if (node->m_left != nullptr) {
+                count += node->m_left->m_numValid;
+            }
+            if (node->m_isValid) {
+                count++;
+            }
+            node = node->m_right;
+        }
+        else {
+            node = node->m_left;
+        }
+    }
+    return count;
+}
+
+
+template<class T>
+int RangeTree<T>::get_valid_recursively(const RangeNode<T>* node, const int minId, const int maxId,
+                                        T* const array, int index) const {
+    if (node == nullptr || node->m_numValid == 0) {
+        return index;
+    }
+    if (node->m_id > minId) {
+        index = get_valid_recursively(node->m_left, minId, maxId, array, index);
+    }
+    if (node->m_isValid && node->m_id >= minId && node->m_id <= maxId) {
+        array[index++] = node->m_data;
+    }
+    if (node->m_id < maxId) {
+        index = get_valid_recursively(node->m_right, minId, maxId, array, index);
+    }
+    return index;
+}
+
+
+//-----------------------------------------Helper Functions-----------------------------------------
+
+template<class T>
+void RangeTree<T>::update_counts(RangeNode<T>* node) {
+    node->update_counts();
+}
+
+
+template<class T>
+void RangeTree<T>::upwardUpdate(RangeNode<T>* starting) {
+    while (starting != nullptr) {
+        starting->update_counts();
+        starting = starting->m_parent;
+    }
+}
+
+//----------------------------------------------------------------------------------------------
+
+#endif //RANGETREE_H
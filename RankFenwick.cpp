@@ -0,0 +1,191 @@
+#include "RankFenwick.h"
+
+namespace {
+
+    /*
+     * A single (ability, team ID) key, and the place in which it was given, used while compressing the keys
+     */
+    struct RankKey {
+        int ability;
+        int id;
+        int given;
+    };
+
+    /*
+     * Order the keys the same way as the rank tree of teams: by ability, and then by ID
+     */
+    struct RankKeyLess {
+        bool operator()(const RankKey& first, const RankKey& second) const {
+            if (first.ability != second.ability) {
+                return first.ability < second.ability;
+            }
+            if (first.id != second.id) {
+                return first.id < second.id;
+            }
+            return first.given < second.given;
+        }
+    };
+
+    const int BLOCK_SIZE = 64;
+
+}
+
+//--------------------------------Constructor and Destructor------------------------------------
+
+RankFenwick::RankFenwick(const int* abilities, const int* teamIds, const int numKeys) :
+    m_abilities(nullptr),
+    m_ids(nullptr),
+    m_bits(nullptr),
+    m_tree(nullptr),
+    m_givenPositions(nullptr),
+    m_nextGiven(0),
+    m_numKeys(0),
+    m_numBlocks(0),
+    m_numGiven(numKeys),
+    m_topStep(1),
+    m_numTeams(0)
+{
+    RankKey* keys = new RankKey[numKeys > 0 ? numKeys : 1];
+    for (int i = 0; i < numKeys; i++) {
+        keys[i].ability = abilities[i];
+        keys[i].id = teamIds[i];
+        keys[i].given = i;
+    }
+    sort_array(keys, numKeys, RankKeyLess());
+    int maxBlocks = numKeys / BLOCK_SIZE + 1;
+    try {
+        m_abilities = new int[numKeys + 1];
+        m_ids = new int[numKeys + 1];
+        m_givenPositions = new int[numKeys + 1];
+        m_bits = new unsigned long long[maxBlocks];
+        m_tree = new int[maxBlocks + 1];
+    }
+    catch (const std::bad_alloc& e) {
+        delete[] keys;
+        delete[] m_abilities;
+        delete[] m_ids;
+        delete[] m_givenPositions;
+        delete[] m_bits;
+        throw e;
+    }
+    //Remove repeating keys, remembering the position of every given key
+    for (int i = 0; i < numKeys; i++) {
+        if (m_numKeys == 0 || keys[i].ability != m_abilities[m_numKeys - 1] || keys[i].id != m_ids[m_numKeys - 1]) {
+            m_abilities[m_numKeys] = keys[i].ability;
+            m_ids[m_numKeys] = keys[i].id;
+            m_numKeys++;
+        }
+        m_givenPositions[keys[i].given] = m_numKeys;
+    }
+    delete[] keys;
+    m_numBlocks = (m_numKeys + BLOCK_SIZE - 1) / BLOCK_SIZE;
+    for (int i = 0; i < maxBlocks; i++) {
+        m_bits[i] = 0;
+    }
+    for (int i = 0; i <= maxBlocks; i++) {
+        m_tree[i] = 0;
+    }
+    while (m_topStep * 2 <= m_numBlocks) {
+        m_topStep *= 2;
+    }
+}
+
+
+RankFenwick::~RankFenwick()
+{
+    delete[] m_abilities;
+    delete[] m_ids;
+    delete[] m_bits;
+    delete[] m_tree;
+    delete[] m_givenPositions;
+}
+
+
+//----------------------------------Insert and Remove---------------------------------
+
+void RankFenwick::insert(const int position)
+{
+    m_bits[(position - 1) / BLOCK_SIZE] |= 1ULL << ((position - 1) % BLOCK_SIZE);
+    update((position - 1) / BLOCK_SIZE + 1, 1);
+    m_numTeams++;
+}
+
+
+void RankFenwick::remove(const int position)
+{
+    m_bits[(position - 1) / BLOCK_SIZE] &= ~(1ULL << ((position - 1) % BLOCK_SIZE));
+    update((position - 1) / BLOCK_SIZE + 1, -1);
+    m_numTeams--;
+}
+
+
+//-----------------------------------------Search Functions-----------------------------------------
+
+int RankFenwick::next_key_position(const int id, const int ability)
+{
+    if (m_nextGiven < m_numGiven) {
+        int position = m_givenPositions[m_nextGiven];
+        if (m_abilities[position - 1] == ability && m_ids[position - 1] == id) {
+            m_nextGiven++;
+            return position;
+        }
+    }
+    return search_key_position(id, ability);
+}
+
+
+int RankFenwick::find_index(const int index) const
+{
+    //Find the last block whose prefix count is at most the index - the requested key is in the block after it
+    int block = 0;
+    int remaining = index;
+    for (int step = m_topStep; step > 0; step /= 2) {
+        if (block + step <= m_numBlocks && m_tree[block + step] <= remaining) {
+            block += step;
+            remaining -= m_tree[block];
+        }
+    }
+    //Skip the teams that come before the requested one inside the block
+    unsigned long long bits = m_bits[block];
+    for (int i = 0; i < remaining; i++) {
+        bits &= bits - 1;
+    }
+    return m_ids[block * BLOCK_SIZE + __builtin_ctzll(bits)];
+}
+
+
+int RankFenwick::get_num_teams() const
+{
+    return m_numTeams;
+}
+
+
+//-----------------------------------------Helper Functions-----------------------------------------
+
+int RankFenwick::search_key_position(const int id, const int ability) const
+{
+    int low = 0;
+    int high = m_numKeys - 1;
+    while (low <= high) {
+        int middle = low + (high - low) / 2;
+        if (m_abilities[middle] == ability && m_ids[middle] == id) {
+            return middle + 1;
+        }
+        if (m_abilities[middle] < ability || (m_abilities[middle] == ability && m_ids[middle] < id)) {
+            low = middle + 1;
+        }
+        else {
+            high = middle - 1;
+        }
+    }
+    return 0;
+}
+
+
+void RankFenwick::update(int block, const int value)
+{
+    while (block <= m_numBlocks) {
+        m_tree[block] += value;
+        block += block & (-block);
+    }
+}
@@ -0,0 +1,120 @@
+#ifndef RANKFENWICK_H
+#define RANKFENWICK_H
+
+#include <new>
+#include "Exception.h"
+#include "Sorting.h"
+
+/*
+* Class RankFenwick
+* This class is used as an offline replacement for the rank tree of teams (MultiTree), when every
+*       (ability, team ID) key that will ever be reached is known in advance.
+* The keys are coordinate-compressed into a sorted array. Every key holds at most one team (a team has a single
+*       key at a time), so the keys are saved as bits in blocks of 64, and a Fenwick tree counts the teams saved
+*       in each block. The i'th team (sorted by ability and then by ID) is found by binary lifting over the blocks,
+*       and then inside the block's bits. The Fenwick tree is 64 times smaller than the keys, so it stays in cache.
+*/
+class RankFenwick {
+public:
+
+    /*
+    * Constructor of RankFenwick class - compresses the given keys (repeating keys are allowed)
+    * @param - arrays of the abilities and team IDs of all the keys, and the number of keys
+    * @return - A new instance of RankFenwick, with no teams saved
+    */
+    RankFenwick(const int* abilities, const int* teamIds, const int numKeys);
+
+    /*
+    * Copy Constructor and Assignment Operator of RankFenwick class
+    * world_cup does not allow two of the same player or team (repeating ID's).
+    * Therefore the system does not allow a copy constructor or assignment operator.
+    */
+    RankFenwick(const RankFenwick& other) = delete;
+    RankFenwick& operator=(const RankFenwick& other) = delete;
+
+    /*
+    * Destructor of RankFenwick class
+    * @param - none
+    * @return - void
+    */
+    ~RankFenwick();
+
+    /*
+     * Find the compressed position of a key.
+     * The keys are usually requested in the same order they were given to the constructor (the order of the
+     *       log), so the next given key is checked first, and a binary search is only needed when it differs.
+     * @param - The ID and ability of the key
+     * @return - the position of the key (positive), or 0 if the key is unknown
+     */
+    int next_key_position(const int id, const int ability);
+
+    /*
+     * Save a team under the key in the given position
+     * @param - The position of the team's key
+     * @return - void
+     */
+    void insert(const int position);
+
+    /*
+     * Remove a team from the key in the given position
+     * @param - The position of the team's key
+     * @return - void
+     */
+    void remove(const int position);
+
+    /*
+     * Helper function for get_ith_pointless_ability:
+     * Find the team that has the given index, using binary lifting over the Fenwick tree
+     * @param - The index to be searched for
+     * @return - the ID of the requested team
+     */
+    int find_index(const int index) const;
+
+    /*
+     * Return the number of teams that are currently saved
+     * @param - none
+     * @return - the number of teams
+     */
+    int get_num_teams() const;
+
+private:
+
+    /*
+     * Binary search for the compressed position of a key
+     * @param - The ID and ability of the key
+     * @return - the position of the key (1-based), or 0 if the key is unknown
+     */
+    int search_key_position(const int id, const int ability) const;
+
+    /*
+     * Add the given value to the count of the given block
+     * @param - the block (1-based) and the value to add
+     * @return - void
+     */
+    void update(int block, const int value);
+
+    /*
+     * The internal fields of RankFenwick:
+     *   The sorted abilities of the compressed keys
+     *   The team IDs of the compressed keys (sorted within every ability)
+     *   The bits of the keys that currently hold a team, 64 keys in each block
+     *   The Fenwick tree of the number of teams saved in each block (1-based)
+     *   The positions of the keys in the order they were given, and the next one expected
+     *   The number of compressed keys, the number of blocks and the number of keys that were given
+     *   The largest power of 2 not larger than the number of blocks (first step of the binary lifting)
+     *   The number of teams currently saved
+     */
+    int* m_abilities;
+    int* m_ids;
+    unsigned long long* m_bits;
+    int* m_tree;
+    int* m_givenPositions;
+    int m_nextGiven;
+    int m_numKeys;
+    int m_numBlocks;
+    int m_numGiven;
+    int m_topStep;
+    int m_numTeams;
+};
+
+#endif //RANKFENWICK_H
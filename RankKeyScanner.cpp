@@ -0,0 +1,127 @@
+#include "RankKeyScanner.h"
+
+//--------------------------------Constructor and Destructor------------------------------------
+
+RankKeyScanner::RankKeyScanner() :
+    m_teamAbilities(),
+    m_players(),
+    m_abilities(nullptr),
+    m_ids(nullptr),
+    m_capacity(0),
+    m_numKeys(0)
+{}
+
+
+RankKeyScanner::~RankKeyScanner()
+{
+    delete[] m_abilities;
+    delete[] m_ids;
+}
+
+
+//---------------------------------------Commands---------------------------------------------
+
+void RankKeyScanner::add_team(const int teamId)
+{
+    if (teamId <= 0 || m_teamAbilities.find(teamId) != nullptr) {
+        return;
+    }
+    m_teamAbilities.insert(teamId, 0);
+    record_key(teamId, 0);
+}
+
+
+void RankKeyScanner::remove_team(const int teamId)
+{
+    if (teamId <= 0 || m_teamAbilities.find(teamId) == nullptr) {
+        return;
+    }
+    m_teamAbilities.remove(teamId);
+}
+
+
+void RankKeyScanner::add_player(const int playerId, const int teamId, const permutation_t& spirit,
+                                const int gamesPlayed, const int ability, const int cards)
+{
+    if (playerId <= 0 || teamId <= 0 || gamesPlayed < 0 || cards < 0 || !spirit.isvalid()) {
+        return;
+    }
+    //The player is checked before the team, exactly like in world_cup
+    if (m_players.find(playerId) != nullptr) {
+        return;
+    }
+    int* teamAbility = m_teamAbilities.find(teamId);
+    if (teamAbility == nullptr) {
+        return;
+    }
+    m_players.insert(playerId, true);
+    *teamAbility += ability;
+    record_key(teamId, *teamAbility);
+}
+
+
+void RankKeyScanner::buy_team(const int teamId1, const int teamId2)
+{
+    if (teamId1 <= 0 || teamId2 <= 0 || teamId1 == teamId2) {
+        return;
+    }
+    int* buyerAbility = m_teamAbilities.find(teamId1);
+    int* boughtAbility = m_teamAbilities.find(teamId2);
+    if (buyerAbility == nullptr || boughtAbility == nullptr) {
+        return;
+    }
+    *buyerAbility += *boughtAbility;
+    record_key(teamId1, *buyerAbility);
+    m_teamAbilities.remove(teamId2);
+}
+
+
+//---------------------------------------Getters---------------------------------------------
+
+const int* RankKeyScanner::get_abilities() const
+{
+    return m_abilities;
+}
+
+
+const int* RankKeyScanner::get_team_ids() const
+{
+    return m_ids;
+}
+
+
+int RankKeyScanner::get_num_keys() const
+{
+    return m_numKeys;
+}
+
+
+//-----------------------------------------Helper Functions-----------------------------------------
+
+void RankKeyScanner::record_key(const int id, const int ability)
+{
+    if (m_numKeys == m_capacity) {
+        int newCapacity = (m_capacity == 0) ? 16 : m_capacity * 2;
+        int* newAbilities = new int[newCapacity];
+        int* newIds;
+        try {
+            newIds = new int[newCapacity];
+        }
+        catch (const std::bad_alloc& e) {
+            delete[] newAbilities;
+            throw e;
+        }
+        for (int i = 0; i < m_numKeys; i++) {
+            newAbilities[i] = m_abilities[i];
+            newIds[i] = m_ids[i];
+        }
+        delete[] m_abilities;
+        delete[] m_ids;
+        m_abilities = newAbilities;
+        m_ids = newIds;
+        m_capacity = newCapacity;
+    }
+    m_abilities[m_numKeys] = ability;
+    m_ids[m_numKeys] = id;
+    m_numKeys++;
+}
@@ -0,0 +1,82 @@
+#ifndef RANKKEYSCANNER_H
+#define RANKKEYSCANNER_H
+
+#include <new>
+#include "wet2util.h"
+#include "HashIndex.h"
+
+/*
+* Class RankKeyScanner
+* This class is used to pre-scan a full command log before it is replayed in offline mode.
+* It follows only the commands that change the teams' abilities (with the same input checks as world_cup),
+*       and records every (ability, team ID) key that the rank of teams will ever reach.
+*/
+class RankKeyScanner {
+public:
+
+    /*
+    * Constructor of RankKeyScanner class
+    * @param - none
+    * @return - A new instance of RankKeyScanner, with no teams or players
+    */
+    RankKeyScanner();
+
+    /*
+    * Copy Constructor and Assignment Operator of RankKeyScanner class
+    * world_cup does not allow two of the same player or team (repeating ID's).
+    * Therefore the system does not allow a copy constructor or assignment operator.
+    */
+    RankKeyScanner(const RankKeyScanner& other) = delete;
+    RankKeyScanner& operator=(const RankKeyScanner& other) = delete;
+
+    /*
+    * Destructor of RankKeyScanner class
+    * @param - none
+    * @return - void
+    */
+    ~RankKeyScanner();
+
+    /*
+     * Follow the matching world_cup commands, recording the keys they create
+     * @param - the same parameters as the world_cup commands
+     * @return - void
+     */
+    void add_team(const int teamId);
+    void remove_team(const int teamId);
+    void add_player(const int playerId, const int teamId, const permutation_t& spirit, const int gamesPlayed,
+                    const int ability, const int cards);
+    void buy_team(const int teamId1, const int teamId2);
+
+    /*
+     * Return the recorded keys (a key may be recorded more than once)
+     * @param - none
+     * @return - arrays of the abilities and team IDs of the keys, and the number of keys
+     */
+    const int* get_abilities() const;
+    const int* get_team_ids() const;
+    int get_num_keys() const;
+
+private:
+
+    /*
+     * Record a new key, enlarging the arrays of keys if needed
+     * @param - the ID and ability of the team
+     * @return - void
+     */
+    void record_key(const int id, const int ability);
+
+    /*
+     * The internal fields of RankKeyScanner:
+     *   The current ability of every team, by team ID
+     *   The IDs of all of the players that were added (the data is not used)
+     *   The arrays of the recorded keys, their size and the number of keys recorded
+     */
+    HashIndex<int> m_teamAbilities;
+    HashIndex<bool> m_players;
+    int* m_abilities;
+    int* m_ids;
+    int m_capacity;
+    int m_numKeys;
+};
+
+#endif //RANKKEYSCANNER_H
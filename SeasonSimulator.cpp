@@ -0,0 +1,179 @@
+#include "SeasonSimulator.h"
+#include "Sorting.h"
+#include <memory.h>
+
+#if defined(__SSE2__)
+#define SEASONSIMULATOR_SSE2
+#include <emmintrin.h>
+#endif
+
+//--------------------------------Constructor and Destructor------------------------------------
+
+SeasonSimulator::SeasonSimulator(const int* teamIds, const int* points, const int* abilities, const int* strengths,
+                                 const int numTeams) :
+    m_ids(nullptr),
+    m_points(nullptr),
+    m_abilities(nullptr),
+    m_strengths(nullptr),
+    m_numPositions(numTeams + numTeams % 2),
+    m_numTeams(numTeams)
+{
+    try {
+        m_ids = new int[m_numPositions + 1];
+        m_points = new int[m_numPositions + 1];
+        m_abilities = new int[m_numPositions + 1];
+        m_strengths = new int[m_numPositions + 1];
+    }
+    catch (const std::bad_alloc& e) {
+        delete[] m_ids;
+        delete[] m_points;
+        delete[] m_abilities;
+        throw e;
+    }
+    //With an odd number of teams, the bye stays in position 0
+    int first = m_numPositions - m_numTeams;
+    if (first == 1) {
+        m_ids[0] = 0;
+        m_points[0] = 0;
+        m_abilities[0] = 0;
+        m_strengths[0] = 0;
+    }
+    for (int i = 0; i < m_numTeams; i++) {
+        m_ids[first + i] = teamIds[i];
+        m_points[first + i] = points[i];
+        m_abilities[first + i] = abilities[i];
+        m_strengths[first + i] = strengths[i];
+    }
+}
+
+
+SeasonSimulator::~SeasonSimulator()
+{
+    delete[] m_ids;
+    delete[] m_points;
+    delete[] m_abilities;
+    delete[] m_strengths;
+}
+
+
+//--------------------------------------------Season--------------------------------------------
+
+void SeasonSimulator::play_season(const SeasonKernel kernel)
+{
+    //The match of position 0 is skipped when it holds the bye
+    int first = m_numPositions - m_numTeams;
+    int numMatches = m_numPositions / 2;
+    for (int round = 0; round + 1 < m_numPositions; round++) {
+#ifdef SEASONSIMULATOR_SSE2
+        if (kernel != SeasonKernel::SCALAR) {
+            play_round_sse2(first, numMatches);
+        }
+        else {
+            play_round_scalar(first, numMatches);
+        }
+#else
+        play_round_scalar(first, numMatches);
+#endif
+        rotate();
+    }
+}
+
+
+void SeasonSimulator::get_standings(int* teamIds, int* points) const
+{
+    int first = m_numPositions - m_numTeams;
+    int* order = new int[m_numTeams + 1];
+    for (int i = 0; i < m_numTeams; i++) {
+        order[i] = first + i;
+    }
+    const int* ids = m_ids;
+    const int* finalPoints = m_points;
+    sort_array(order, m_numTeams, [ids, finalPoints](const int a, const int b) {
+        return finalPoints[a] > finalPoints[b] || (finalPoints[a] == finalPoints[b] && ids[a] < ids[b]);
+    });
+    for (int i = 0; i < m_numTeams; i++) {
+        teamIds[i] = m_ids[order[i]];
+        points[i] = m_points[order[i]];
+    }
+    delete[] order;
+}
+
+
+//---------------------------------------Helper Functions---------------------------------------
+
+void SeasonSimulator::play_round_scalar(const int from, const int to)
+{
+    for (int i = from; i < to; i++) {
+        int a = i;
+        int b = m_numPositions - 1 - i;
+        int scoreA = m_points[a] + m_abilities[a];
+        int scoreB = m_points[b] + m_abilities[b];
+        if (scoreA > scoreB) {
+            m_points[a] += 3;
+        }
+        else if (scoreB > scoreA) {
+            m_points[b] += 3;
+        }
+        else if (m_strengths[a] > m_strengths[b]) {
+            m_points[a] += 3;
+        }
+        else if (m_strengths[b] > m_strengths[a]) {
+            m_points[b] += 3;
+        }
+        else {
+            m_points[a] += 1;
+            m_points[b] += 1;
+        }
+    }
+}
+
+
+void SeasonSimulator::play_round_sse2(const int from, const int to)
+{
+#ifdef SEASONSIMULATOR_SSE2
+    const __m128i three = _mm_set1_epi32(3);
+    const __m128i one = _mm_set1_epi32(1);
+    int i = from;
+    for (; i + 4 <= to; i += 4) {
+        //The first teams are positions [i, i+4), and the second teams are [n-4-i, n-i), backwards
+        int last = m_numPositions - 4 - i;
+        __m128i pointsA = _mm_loadu_si128((const __m128i*)(m_points + i));
+        __m128i pointsB = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i*)(m_points + last)), 0x1B);
+        __m128i scoreA = _mm_add_epi32(pointsA, _mm_loadu_si128((const __m128i*)(m_abilities + i)));
+        __m128i scoreB = _mm_add_epi32(pointsB,
+                _mm_shuffle_epi32(_mm_loadu_si128((const __m128i*)(m_abilities + last)), 0x1B));
+        __m128i strengthA = _mm_loadu_si128((const __m128i*)(m_strengths + i));
+        __m128i strengthB = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i*)(m_strengths + last)), 0x1B);
+        //Every comparison gives a mask of all ones where it holds
+        __m128i sameScore = _mm_cmpeq_epi32(scoreA, scoreB);
+        __m128i strongerA = _mm_cmpgt_epi32(strengthA, strengthB);
+        __m128i strongerB = _mm_cmpgt_epi32(strengthB, strengthA);
+        __m128i winA = _mm_or_si128(_mm_cmpgt_epi32(scoreA, scoreB), _mm_and_si128(sameScore, strongerA));
+        __m128i winB = _mm_or_si128(_mm_cmpgt_epi32(scoreB, scoreA), _mm_and_si128(sameScore, strongerB));
+        __m128i tie = _mm_andnot_si128(_mm_or_si128(strongerA, strongerB), sameScore);
+        __m128i tiePoints = _mm_and_si128(tie, one);
+        pointsA = _mm_add_epi32(pointsA, _mm_or_si128(_mm_and_si128(winA, three), tiePoints));
+        pointsB = _mm_add_epi32(pointsB, _mm_or_si128(_mm_and_si128(winB, three), tiePoints));
+        _mm_storeu_si128((__m128i*)(m_points + i), pointsA);
+        _mm_storeu_si128((__m128i*)(m_points + last), _mm_shuffle_epi32(pointsB, 0x1B));
+    }
+    play_round_scalar(i, to);
+#else
+    play_round_scalar(from, to);
+#endif
+}
+
+
+void SeasonSimulator::rotate()
+{
+    int last = m_numPositions - 1;
+    if (last < 2) {
+        return;
+    }
+    int* arrays[4] = {m_ids, m_points, m_abilities, m_strengths};
+    for (int k = 0; k < 4; k++) {
+        int moved = arrays[k][last];
+        memmove(arrays[k] + 2, arrays[k] + 1, (last - 1) * sizeof(int));
+        arrays[k][1] = moved;
+    }
+}
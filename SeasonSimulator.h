@@ -0,0 +1,104 @@
+#ifndef SEASONSIMULATOR_H
+#define SEASONSIMULATOR_H
+
+#include <new>
+
+/*
+* The kernels that SeasonSimulator::play_season can use:
+*   BEST - SSE2 when the program is compiled for a processor that has it, otherwise SCALAR
+*   SCALAR - one match at a time
+*   SSE2 - 4 matches of a round at a time
+*/
+enum struct SeasonKernel {
+    BEST,
+    SCALAR,
+    SSE2
+};
+
+/*
+* Class SeasonSimulator
+* This class is used to play a "what-if" round-robin season on a copy of the teams, without changing world_cup.
+* Every team plays every other team once, by the circle method: the teams are placed in n (even) positions, and in
+*       every one of the n - 1 rounds the team in position i plays the team in position n - 1 - i. Between the rounds
+*       position 0 stays, and the others rotate by one. With an odd number of teams, position 0 holds a bye.
+* The matches are decided the same way as play_match (score = points + ability, then spirit strength, 3 points for a
+*       win and 1 for a tie). The points, abilities and spirit strengths are saved in arrays by position, so the first
+*       teams of a round's matches are a contiguous range of an array, and the second teams are the same range of
+*       positions, backwards. Every team plays at most once in a round, so the matches of a round are independent and
+*       are decided 4 at a time with SSE2.
+*/
+class SeasonSimulator {
+public:
+
+    /*
+    * Constructor of SeasonSimulator class
+    * @param - the IDs, points, abilities and spirit strengths of the teams (sorted by ID, which is the order of the
+    *          first round), and the number of teams
+    * @return - A new instance of SeasonSimulator, before the season
+    */
+    SeasonSimulator(const int* teamIds, const int* points, const int* abilities, const int* strengths,
+                    const int numTeams);
+
+    /*
+    * Copy Constructor and Assignment Operator of SeasonSimulator class
+    * world_cup does not allow two of the same player or team (repeating ID's).
+    * Therefore the system does not allow a copy constructor or assignment operator.
+    */
+    SeasonSimulator(const SeasonSimulator& other) = delete;
+    SeasonSimulator& operator=(const SeasonSimulator& other) = delete;
+
+    /*
+    * Destructor of SeasonSimulator class
+    * @param - none
+    * @return - void
+    */
+    ~SeasonSimulator();
+
+    /*
+     * Play all of the rounds of the season
+     * @param - the kernel (SSE2 falls back to SCALAR when the program is not compiled for it)
+     * @return - void
+     */
+    void play_season(const SeasonKernel kernel = SeasonKernel::BEST);
+
+    /*
+     * Write the standings: the teams sorted by their points (highest first), and then by their ID
+     * @param - arrays (of the number of teams) that receive the team IDs and their points
+     * @return - void
+     */
+    void get_standings(int* teamIds, int* points) const;
+
+private:
+
+    /*
+     * Play the matches [from, to) of the current round one at a time
+     * @return - void
+     */
+    void play_round_scalar(const int from, const int to);
+
+    /*
+     * Play the matches [from, to) of the current round 4 at a time (and the rest one at a time)
+     * @return - void
+     */
+    void play_round_sse2(const int from, const int to);
+
+    /*
+     * Move every team except for the one in position 0 to the next position (the last one to position 1)
+     * @return - void
+     */
+    void rotate();
+
+    /*
+     * The internal fields of SeasonSimulator, every array by position (a bye has the ID 0):
+     *   The IDs, points, abilities and spirit strengths of the teams
+     *   The number of positions (even), and the number of teams
+     */
+    int* m_ids;
+    int* m_points;
+    int* m_abilities;
+    int* m_strengths;
+    int m_numPositions;
+    int m_numTeams;
+};
+
+#endif //SEASONSIMULATOR_H
@@ -0,0 +1,52 @@
+#ifndef SORTING_H
+#define SORTING_H
+
+/*
+* Helper functions used to sort arrays in place (heap sort), without any additional memory.
+* The order is given by a comparison object: less(a, b) returns true when a must come before b.
+*/
+
+/*
+ * Move the element at the given index down the heap until both of its children are not larger than it
+ * @param - the array, the index of the element, the size of the heap and the comparison object
+ * @return - void
+ */
+template <class T, class Less>
+void sift_down(T* array, int index, const int size, Less less)
+{
+    while (2 * index + 1 < size) {
+        int child = 2 * index + 1;
+        if (child + 1 < size && less(array[child], array[child + 1])) {
+            child++;
+        }
+        if (!less(array[index], array[child])) {
+            return;
+        }
+        T tmp = array[index];
+        array[index] = array[child];
+        array[child] = tmp;
+        index = child;
+    }
+}
+
+
+/*
+ * Sort the array in place, according to the comparison object
+ * @param - the array, its size and the comparison object
+ * @return - void
+ */
+template <class T, class Less>
+void sort_array(T* array, const int size, Less less)
+{
+    for (int i = size / 2 - 1; i >= 0; i--) {
+        sift_down(array, i, size, less);
+    }
+    for (int last = size - 1; last > 0; last--) {
+        T tmp = array[0];
+        array[0] = array[last];
+        array[last] = tmp;
+        sift_down(array, 0, last, less);
+    }
+}
+
+#endif //SORTING_H
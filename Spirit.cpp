@@ -0,0 +1,164 @@
+#include "Spirit.h"
+
+namespace {
+
+    const int N = permutation_t::N;
+
+    /*
+     * Return the rank of a permutation in lexicographic order (its Lehmer code)
+     */
+    int permutation_rank(const int* elements)
+    {
+        int rank = 0;
+        for (int i = 0; i < N; i++) {
+            int smallerAfter = 0;
+            for (int j = i + 1; j < N; j++) {
+                if (elements[j] < elements[i]) {
+                    smallerAfter++;
+                }
+            }
+            rank = rank * (N - i) + smallerAfter;
+        }
+        return rank;
+    }
+
+}
+
+//----------------------------------------------Tables----------------------------------------------
+
+unsigned char Spirit::s_elements[NUM_PERMUTATIONS][permutation_t::N];
+unsigned char Spirit::s_compose[NUM_RANKS][NUM_RANKS];
+unsigned char Spirit::s_inverse[NUM_RANKS];
+short Spirit::s_strength[NUM_RANKS];
+const bool Spirit::s_tablesBuilt = Spirit::build_tables();
+
+
+bool Spirit::build_tables()
+{
+    //The elements of every rank: the digits of the rank in the factorial base choose from the unused elements
+    for (int rank = 0; rank < NUM_PERMUTATIONS; rank++) {
+        bool used[N] = {false, false, false, false, false};
+        int remaining = rank;
+        int factorial = NUM_PERMUTATIONS;
+        for (int i = 0; i < N; i++) {
+            factorial /= (N - i);
+            int digit = remaining / factorial;
+            remaining %= factorial;
+            int element = 0;
+            while (used[element] || digit > 0) {
+                if (!used[element]) {
+                    digit--;
+                }
+                element++;
+            }
+            used[element] = true;
+            s_elements[rank][i] = (unsigned char)element;
+        }
+    }
+    for (int p = 0; p < NUM_PERMUTATIONS; p++) {
+        int inverse[N];
+        int strength = 0;
+        for (int i = 0; i < N; i++) {
+            inverse[s_elements[p][i]] = i;
+            strength += (i + 1) * (s_elements[p][i] + 1);
+        }
+        s_inverse[p] = (unsigned char)permutation_rank(inverse);
+        s_strength[p] = (short)strength;
+        //Composition the same way as permutation_t: (p * q)[i] = p[q[i]]
+        for (int q = 0; q < NUM_PERMUTATIONS; q++) {
+            int composed[N];
+            for (int i = 0; i < N; i++) {
+                composed[i] = s_elements[p][s_elements[q][i]];
+            }
+            s_compose[p][q] = (unsigned char)permutation_rank(composed);
+        }
+        s_compose[p][INVALID_RANK] = INVALID_RANK;
+        s_compose[INVALID_RANK][p] = INVALID_RANK;
+    }
+    s_compose[INVALID_RANK][INVALID_RANK] = INVALID_RANK;
+    s_inverse[INVALID_RANK] = INVALID_RANK;
+    s_strength[INVALID_RANK] = 0;
+    return true;
+}
+
+
+//------------------------------------------Constructors------------------------------------------
+
+Spirit::Spirit() :
+    m_rank(INVALID_RANK)
+{}
+
+
+Spirit::Spirit(const unsigned char rank) :
+    m_rank(rank)
+{}
+
+
+Spirit::Spirit(const permutation_t& permutation) :
+    m_rank(INVALID_RANK)
+{
+    if (!permutation.isvalid()) {
+        return;
+    }
+    //The elements of permutation_t are private, so they are recovered from strengths: swapping the elements in
+    //places 0 and k lowers the strength by k * (p[k] - p[0])
+    int base = permutation.strength();
+    int offsets[N];
+    offsets[0] = 0;
+    int lowest = 0;
+    for (int k = 1; k < N; k++) {
+        int swap[N];
+        for (int i = 0; i < N; i++) {
+            swap[i] = i;
+        }
+        swap[0] = k;
+        swap[k] = 0;
+        offsets[k] = (base - (permutation * permutation_t(swap)).strength()) / k;
+        if (offsets[k] < lowest) {
+            lowest = offsets[k];
+        }
+    }
+    //The smallest element is 0
+    int elements[N];
+    for (int i = 0; i < N; i++) {
+        elements[i] = offsets[i] - lowest;
+    }
+    m_rank = (unsigned char)permutation_rank(elements);
+}
+
+
+Spirit Spirit::neutral()
+{
+    return Spirit((unsigned char)0);
+}
+
+
+permutation_t Spirit::to_permutation() const
+{
+    if (m_rank == INVALID_RANK) {
+        return permutation_t::invalid();
+    }
+    int elements[N];
+    for (int i = 0; i < N; i++) {
+        elements[i] = s_elements[m_rank][i];
+    }
+    return permutation_t(elements);
+}
+
+
+void Spirit::to_packed(unsigned char* bytes) const
+{
+    for (int i = 0; i < N; i++) {
+        bytes[i] = s_elements[m_rank][i];
+    }
+}
+
+
+Spirit Spirit::from_packed(const unsigned char* bytes)
+{
+    int elements[N];
+    for (int i = 0; i < N; i++) {
+        elements[i] = bytes[i];
+    }
+    return Spirit((unsigned char)permutation_rank(elements));
+}
@@ -0,0 +1,150 @@
+#ifndef SPIRIT_H
+#define SPIRIT_H
+
+#include "wet2util.h"
+
+/*
+* Class Spirit
+* This class is used as the internal representation of a spirit (a permutation_t of N = 5 elements).
+* There are only 5! = 120 permutations, so a spirit is saved as the rank of its permutation in lexicographic order
+*       (a single byte), and composing, inverting and computing the strength are single loads from tables that are
+*       built once, when the program starts. The spirits are converted to and from permutation_t only at the
+*       world_cup API.
+*/
+class Spirit {
+public:
+
+    /*
+    * Constructor of Spirit class
+    * @param - none
+    * @return - A new instance of Spirit, invalid (like the default permutation_t)
+    */
+    Spirit();
+
+    /*
+    * Constructor of Spirit class
+    * @param - the permutation to convert
+    * @return - A new instance of Spirit, or an invalid one if the permutation is invalid
+    */
+    explicit Spirit(const permutation_t& permutation);
+
+    /*
+    * Copy Constructor, Assignment Operator and Destructor of Spirit class - a spirit is a single byte
+    */
+    Spirit(const Spirit& other) = default;
+    Spirit& operator=(const Spirit& other) = default;
+    ~Spirit() = default;
+
+    /*
+    * Return the neutral spirit (the identity permutation)
+    * @return - Spirit
+    */
+    static Spirit neutral();
+
+    /*
+    * Convert the spirit back to a permutation_t
+    * @return - permutation_t
+    */
+    permutation_t to_permutation() const;
+
+    /*
+    * Write the elements of a valid spirit into N bytes (the packed form used by compose_packed in SpiritBatch.h)
+    * @param - the bytes to write
+    * @return - void
+    */
+    void to_packed(unsigned char* bytes) const;
+
+    /*
+    * Read a valid spirit from its N packed bytes
+    * @param - the bytes to read
+    * @return - Spirit
+    */
+    static Spirit from_packed(const unsigned char* bytes);
+
+    /*
+    * Compose two spirits, the same way as permutation_t::operator*
+    * @return - Spirit
+    */
+    Spirit operator*(const Spirit& other) const;
+
+    /*
+    * Return the inverse of the spirit
+    * @return - Spirit
+    */
+    Spirit inv() const;
+
+    /*
+    * Return the strength of the spirit, the same way as permutation_t::strength (0 for an invalid spirit)
+    * @return - integer of the strength
+    */
+    int strength() const;
+
+    /*
+    * Return if the spirit is valid
+    * @return - bool
+    */
+    bool isvalid() const;
+
+private:
+
+    /*
+    * Constructor of Spirit class, from the rank of the permutation
+    */
+    explicit Spirit(const unsigned char rank);
+
+    /*
+    * Build the tables of all the permutations (called once, when the program starts)
+    * @return - true
+    */
+    static bool build_tables();
+
+    enum {
+        NUM_PERMUTATIONS = 120,
+        INVALID_RANK = 120,
+        NUM_RANKS = 121
+    };
+
+    /*
+     * The internal fields of Spirit:
+     *   The rank of the permutation in lexicographic order (INVALID_RANK for an invalid spirit)
+     * The tables shared by all of the spirits (the invalid rank composes and inverts to itself):
+     *   The elements of every permutation
+     *   The rank of the composition of every two permutations
+     *   The rank of the inverse of every permutation
+     *   The strength of every permutation
+     */
+    unsigned char m_rank;
+
+    static unsigned char s_elements[NUM_PERMUTATIONS][permutation_t::N];
+    static unsigned char s_compose[NUM_RANKS][NUM_RANKS];
+    static unsigned char s_inverse[NUM_RANKS];
+    static short s_strength[NUM_RANKS];
+    static const bool s_tablesBuilt;
+};
+
+//------------------------------------------Operations-------------------------------------------
+
+inline Spirit Spirit::operator*(const Spirit& other) const
+{
+    return Spirit(s_compose[m_rank][other.m_rank]);
+}
+
+
+inline Spirit Spirit::inv() const
+{
+    return Spirit(s_inverse[m_rank]);
+}
+
+
+inline int Spirit::strength() const
+{
+    return s_strength[m_rank];
+}
+
+
+inline bool Spirit::isvalid() const
+{
+    return m_rank != INVALID_RANK;
+}
+
+#endif //SPIRIT_H
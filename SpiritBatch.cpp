@@ -0,0 +1,130 @@
+#include "SpiritBatch.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define SPIRITBATCH_X86
+#include <immintrin.h>
+#endif
+
+namespace {
+
+    const int N = 5;
+
+    /*
+     * Compose the permutations in places [from, count) one byte at a time
+     */
+    void compose_scalar(const unsigned char* first, const unsigned char* second, unsigned char* result,
+                        const int from, const int count)
+    {
+        for (int i = N * from; i < N * count; i += N) {
+            for (int j = 0; j < N; j++) {
+                result[i + j] = first[i + second[i + j]];
+            }
+        }
+    }
+
+#ifdef SPIRITBATCH_X86
+
+    /*
+     * Compose 3 permutations (15 bytes) with every 16-byte shuffle.
+     * The indices of the second permutation in the lane are shifted by 5 and of the third by 10, and the 16th index
+     *       has its high bit set, so the shuffle writes 0 there. Every store writes that byte over the first byte of the
+     *       next permutation, which the next store (or the scalar loop) writes again.
+     * @return - the number of permutations composed
+     */
+    __attribute__((target("ssse3")))
+    int compose_ssse3(const unsigned char* first, const unsigned char* second, unsigned char* result, const int count)
+    {
+        const __m128i offsets = _mm_setr_epi8(0, 0, 0, 0, 0, 5, 5, 5, 5, 5, 10, 10, 10, 10, 10, (char)0x80);
+        int i = 0;
+        for (; N * i + 16 <= N * count; i += 3) {
+            __m128i p = _mm_loadu_si128((const __m128i*)(first + N * i));
+            __m128i q = _mm_loadu_si128((const __m128i*)(second + N * i));
+            __m128i composed = _mm_shuffle_epi8(p, _mm_add_epi8(q, offsets));
+            _mm_storeu_si128((__m128i*)(result + N * i), composed);
+        }
+        return i;
+    }
+
+
+    /*
+     * Compose 6 permutations with every 32-byte shuffle: the shuffle works inside 16-byte lanes, so every lane is
+     *       loaded with 3 permutations, the same way as compose_ssse3.
+     * @return - the number of permutations composed
+     */
+    __attribute__((target("avx2")))
+    int compose_avx2(const unsigned char* first, const unsigned char* second, unsigned char* result, const int count)
+    {
+        const __m256i offsets = _mm256_setr_epi8(0, 0, 0, 0, 0, 5, 5, 5, 5, 5, 10, 10, 10, 10, 10, (char)0x80,
+                                                 0, 0, 0, 0, 0, 5, 5, 5, 5, 5, 10, 10, 10, 10, 10, (char)0x80);
+        int i = 0;
+        for (; N * i + 31 <= N * count; i += 6) {
+            __m256i p = _mm256_inserti128_si256(
+                    _mm256_castsi128_si256(_mm_loadu_si128((const __m128i*)(first + N * i))),
+                    _mm_loadu_si128((const __m128i*)(first + N * i + 15)), 1);
+            __m256i q = _mm256_inserti128_si256(
+                    _mm256_castsi128_si256(_mm_loadu_si128((const __m128i*)(second + N * i))),
+                    _mm_loadu_si128((const __m128i*)(second + N * i + 15)), 1);
+            __m256i composed = _mm256_shuffle_epi8(p, _mm256_add_epi8(q, offsets));
+            //The low lane first: its 16th byte is then written again by the high lane
+            _mm_storeu_si128((__m128i*)(result + N * i), _mm256_castsi256_si128(composed));
+            _mm_storeu_si128((__m128i*)(result + N * i + 15), _mm256_extracti128_si256(composed, 1));
+        }
+        return i;
+    }
+
+#endif
+
+    /*
+     * Return the fastest kernel the processor supports
+     */
+    PackedKernel best_kernel()
+    {
+        if (packed_kernel_supported(PackedKernel::AVX2)) {
+            return PackedKernel::AVX2;
+        }
+        if (packed_kernel_supported(PackedKernel::SSSE3)) {
+            return PackedKernel::SSSE3;
+        }
+        return PackedKernel::SCALAR;
+    }
+
+}
+
+
+bool packed_kernel_supported(const PackedKernel kernel)
+{
+    switch (kernel) {
+#ifdef SPIRITBATCH_X86
+        case PackedKernel::SSSE3:
+            return __builtin_cpu_supports("ssse3");
+        case PackedKernel::AVX2:
+            return __builtin_cpu_supports("avx2");
+#endif
+        case PackedKernel::BEST:
+        case PackedKernel::SCALAR:
+            return true;
+        default:
+            return false;
+    }
+}
+
+
+void compose_packed(const unsigned char* first, const unsigned char* second, unsigned char* result, const int count,
+                    const PackedKernel kernel)
+{
+    static const PackedKernel best = best_kernel();
+    PackedKernel chosen = (kernel == PackedKernel::BEST) ? best : kernel;
+    if (!packed_kernel_supported(chosen)) {
+        chosen = PackedKernel::SCALAR;
+    }
+    int done = 0;
+#ifdef SPIRITBATCH_X86
+    if (chosen == PackedKernel::AVX2) {
+        done = compose_avx2(first, second, result, count);
+    }
+    if (chosen == PackedKernel::AVX2 || chosen == PackedKernel::SSSE3) {
+        done += compose_ssse3(first + N * done, second + N * done, result + N * done, count - done);
+    }
+#endif
+    compose_scalar(first, second, result, done, count);
+}
@@ -0,0 +1,43 @@
+#ifndef SPIRITBATCH_H
+#define SPIRITBATCH_H
+
+/*
+* Helper functions used to compose many spirits at once.
+* Every permutation is packed into N = 5 bytes (its elements, see Spirit::to_packed), and the permutations of an array
+*       are saved one after another, so 3 permutations fit in 16 bytes. The composition p * q of a permutation is
+*       p[q[i]] for every i, which is a single byte shuffle (pshufb) of p by the indices of q, once the indices are
+*       shifted to the permutation's place inside the 16 bytes. The vector kernels are compiled for their own
+*       instruction set and chosen when the program runs, so the rest of the code does not require them.
+*/
+
+/*
+* The kernels that compose_packed can use:
+*   BEST - the fastest kernel the processor supports
+*   SCALAR - a plain loop over the bytes, on any processor
+*   SSSE3 - 3 permutations in each 16-byte shuffle
+*   AVX2 - 6 permutations in each 32-byte shuffle
+*/
+enum struct PackedKernel {
+    BEST,
+    SCALAR,
+    SSSE3,
+    AVX2
+};
+
+/*
+ * Compose arrays of packed permutations: result[i] = first[i] * second[i] (the same as permutation_t::operator*)
+ * @param - the two arrays of packed permutations, the array that receives the compositions (it may not overlap the
+ *          other two arrays), the number of permutations, and the kernel (an unsupported kernel falls back to SCALAR)
+ * @return - void
+ */
+void compose_packed(const unsigned char* first, const unsigned char* second, unsigned char* result, const int count,
+                    const PackedKernel kernel = PackedKernel::BEST);
+
+/*
+ * Check if the processor supports the given kernel
+ * @param - the kernel
+ * @return - true if compose_packed can use the kernel
+ */
+bool packed_kernel_supported(const PackedKernel kernel);
+
+#endif //SPIRITBATCH_H
@@ -0,0 +1,139 @@
+#include "TeamSlots.h"
+#include "Teams.h"
+#include <cstdint>
+
+namespace {
+
+    /*
+     * The distance between two teams in a chunk: the size of a team, rounded up to whole cache lines
+     */
+    const int TEAM_STRIDE = (int)((sizeof(Team) + TeamSlots::CACHE_LINE - 1) / TeamSlots::CACHE_LINE) *
+                            TeamSlots::CACHE_LINE;
+
+}
+
+int TeamSlots::s_nextEpoch = 0;
+
+//--------------------------------Constructor and Destructor------------------------------------
+
+TeamSlots::TeamSlots() :
+    m_slots(nullptr),
+    m_firstFree(NO_SLOT),
+    m_size(0),
+    m_capacity(0),
+    m_numChunks(0),
+    m_epoch(s_nextEpoch++)
+{
+    enlarge(16);
+}
+
+
+TeamSlots::~TeamSlots()
+{
+    for (int i = 0; i < m_size; i++) {
+        if (m_slots[i].nextFree == IN_USE) {
+            m_slots[i].team->~Team();
+        }
+    }
+    for (int i = 0; i < m_numChunks; i++) {
+        delete[] m_chunks[i];
+    }
+    delete[] m_slots;
+}
+
+
+//--------------------------------------Acquire and Release--------------------------------------
+
+Team* TeamSlots::acquire(const int teamId)
+{
+    int slot = m_firstFree;
+    if (slot != NO_SLOT) {
+        m_firstFree = m_slots[slot].nextFree;
+    }
+    else {
+        if (m_size == m_capacity) {
+            enlarge(m_capacity * 2);
+        }
+        slot = m_size++;
+    }
+    Team* team = new (m_slots[slot].team) Team(teamId);
+    team->update_slot(slot);
+    m_slots[slot].nextFree = IN_USE;
+    return team;
+}
+
+
+void TeamSlots::release(const int slot)
+{
+    m_slots[slot].team->~Team();
+    m_slots[slot].generation++;
+    m_slots[slot].nextFree = m_firstFree;
+    m_firstFree = slot;
+}
+
+
+void TeamSlots::reserve(const int numTeams)
+{
+    int newCapacity = m_capacity;
+    while (newCapacity - m_size < numTeams) {
+        newCapacity *= 2;
+    }
+    if (newCapacity != m_capacity) {
+        enlarge(newCapacity);
+    }
+}
+
+
+//-------------------------------------------Getters--------------------------------------------
+
+TeamHandle TeamSlots::get_handle(const int slot) const
+{
+    TeamHandle handle;
+    handle.slot = slot;
+    handle.generation = m_slots[slot].generation;
+    handle.epoch = m_epoch;
+    return handle;
+}
+
+
+Team* TeamSlots::get_team(const TeamHandle& handle) const
+{
+    if (handle.epoch != m_epoch || handle.slot < 0 || handle.slot >= m_size ||
+        m_slots[handle.slot].generation != handle.generation) {
+        return nullptr;
+    }
+    return m_slots[handle.slot].team;
+}
+
+
+//---------------------------------------Helper Functions---------------------------------------
+
+void TeamSlots::enlarge(const int newCapacity)
+{
+    int numNew = newCapacity - m_capacity;
+    //Allocate the chunk and the slots before changing anything, so that a failure leaves the slots as they were
+    char* chunk = new char[numNew * TEAM_STRIDE + CACHE_LINE - 1];
+    Slot* slots;
+    try {
+        slots = new Slot[newCapacity];
+    }
+    catch (const std::bad_alloc& e) {
+        delete[] chunk;
+        throw e;
+    }
+    for (int i = 0; i < m_capacity; i++) {
+        slots[i] = m_slots[i];
+    }
+    //The first team of the chunk starts on a cache line, and so does every team after it
+    std::uintptr_t address = reinterpret_cast<std::uintptr_t>(chunk);
+    char* first = chunk + (CACHE_LINE - address % CACHE_LINE) % CACHE_LINE;
+    for (int i = 0; i < numNew; i++) {
+        slots[m_capacity + i].team = reinterpret_cast<Team*>(first + i * TEAM_STRIDE);
+        slots[m_capacity + i].generation = 0;
+        slots[m_capacity + i].nextFree = NO_SLOT;
+    }
+    delete[] m_slots;
+    m_slots = slots;
+    m_chunks[m_numChunks++] = chunk;
+    m_capacity = newCapacity;
+}
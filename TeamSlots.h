@@ -0,0 +1,157 @@
+#ifndef TEAMSLOTS_H
+#define TEAMSLOTS_H
+
+class Team;
+
+#include <new>
+
+/*
+* A stable reference to a team of world_cup: the team's slot in TeamSlots, the generation of the slot when the
+*       handle was made, and the epoch of the TeamSlots (so that a handle of another world_cup is not accepted).
+*       Once the team is removed (or bought) the slot's generation advances, so the handle no longer refers to any
+*       team, even after the slot is given to a new team.
+*/
+struct TeamHandle {
+    int slot;
+    int generation;
+    int epoch;
+};
+
+/*
+* A stable reference to a player of world_cup: the player's index in PlayerTable, and the epoch of the PlayerTable
+*       when the handle was made (so that a handle of another world_cup is not accepted).
+* The players are never removed from the table (a player of a removed team stays, without a team), so the index of a
+*       player is only given to another player after the table is cleared (merge_from empties the other world_cup),
+*       which changes the table's epoch, and needs no generation.
+*/
+struct PlayerHandle {
+    int index;
+    int epoch;
+};
+
+/*
+* Class TeamSlots
+* This class is used to give every team of world_cup a slot, so that a TeamHandle finds the team with a single array
+*       access instead of a search by ID. The slots of removed teams are reused (through a list of free slots), and
+*       every slot counts its generation: the number of teams that were released from it. Every TeamSlots also has
+*       an epoch that no other TeamSlots has, which its handles carry.
+* The slots also hold the teams themselves: every slot owns the memory of one team, which is built in it when the slot
+*       is acquired and destroyed when it is released (instead of a separate new and delete for every team). The
+*       memory of the slots is allocated in chunks, one for every time the slots are enlarged, and every team starts
+*       on a cache line of its own, so the fields a match reads are a single cache line, and the teams that were added
+*       one after the other are next to each other in memory.
+*/
+class TeamSlots {
+public:
+
+    /*
+    * NO_SLOT - the end of the list of free slots, and the slot of an invalid handle
+    * IN_USE - the next free slot of a slot that holds a team
+    * CACHE_LINE - the alignment of the teams, in bytes
+    * MAX_CHUNKS - the number of chunks of memory (the capacity doubles every time, so this is never reached)
+    */
+    enum {
+        NO_SLOT = -1,
+        IN_USE = -2,
+        CACHE_LINE = 64,
+        MAX_CHUNKS = 32
+    };
+
+    /*
+    * Constructor of TeamSlots class
+    * @param - none
+    * @return - A new instance of TeamSlots, with no teams
+    */
+    TeamSlots();
+
+    /*
+    * Copy Constructor and Assignment Operator of TeamSlots class
+    * world_cup does not allow two of the same player or team (repeating ID's).
+    * Therefore the system does not allow a copy constructor or assignment operator.
+    */
+    TeamSlots(const TeamSlots& other) = delete;
+    TeamSlots& operator=(const TeamSlots& other) = delete;
+
+    /*
+    * Destructor of TeamSlots class
+    * @param - none
+    * @return - void
+    */
+    ~TeamSlots();
+
+    /*
+     * Build a new team in a slot (a free one if there is, otherwise a new one)
+     * @param - the ID of the team
+     * @return - a pointer to the new team, which knows its slot
+     */
+    Team* acquire(const int teamId);
+
+    /*
+     * Destroy the team in a slot after it was removed, free the slot, and advance its generation
+     * @param - the slot
+     * @return - void
+     */
+    void release(const int slot);
+
+    /*
+     * Make sure the given number of new teams can be acquired without enlarging the slots
+     * @param - the number of new teams
+     * @return - void
+     */
+    void reserve(const int numTeams);
+
+    /*
+     * Return the handle of the team in the given slot
+     * @param - the slot
+     * @return - the handle
+     */
+    TeamHandle get_handle(const int slot) const;
+
+    /*
+     * Return the team a handle refers to
+     * @param - the handle
+     * @return - a pointer to the team, or nullptr if the handle is invalid, its team was removed, or it belongs to
+     *           other slots
+     */
+    Team* get_team(const TeamHandle& handle) const;
+
+private:
+
+    /*
+    * Enlarge the array to the given capacity, keeping the saved slots, and allocate a chunk of memory for the teams of
+    *       the new slots
+    * @return - void
+    */
+    void enlarge(const int newCapacity);
+
+    /*
+     * A slot: the memory of its team (which only holds a team while the slot is in use), its generation, and the next
+     *       free slot after it (IN_USE for a slot in use, and NO_SLOT at the end of the list of free slots). The fields
+     *       of a slot are kept together, so a handle is checked and followed with a single memory access.
+     */
+    struct Slot {
+        Team* team;
+        int generation;
+        int nextFree;
+    };
+
+    /*
+     * The internal fields of TeamSlots:
+     *   The slots
+     *   The first free slot (NO_SLOT if there is none), the number of slots in use or freed, and the number of slots
+     *       the array can hold
+     *   The chunks of memory of the teams, and their number
+     *   The epoch of the slots
+     * The epoch of the next TeamSlots that is created
+     */
+    Slot* m_slots;
+    int m_firstFree;
+    int m_size;
+    int m_capacity;
+    char* m_chunks[MAX_CHUNKS];
+    int m_numChunks;
+    int m_epoch;
+    static int s_nextEpoch;
+};
+
+#endif //TEAMSLOTS_H
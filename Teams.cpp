@@ -3,31 +3,43 @@
 //--------------------------------Constructors and Destructor----------------------------
 
 Team::Team(const int teamID) :
-        m_id(teamID),
         m_points(0),
-        m_numPlayers(0),
+        m_totalAbility(0),
         m_numGoalkeepers(0),
         m_numGames(0),
-        m_totalAbility(0),
+        m_id(teamID),
+        m_historyId(0),
+        m_lastMatch(MatchHistory::NO_MATCH),
         m_teamSpirit(),
-        m_players(nullptr)
+        m_numPlayers(0),
+        m_totalCards(0),
+        m_playerGames(0),
+        m_players(PlayerTable::NO_PLAYER),
+        m_rankKey(0),
+        m_slot(0)
 {}
 
 
 Team::Team() :
-        m_id(0),
         m_points(0),
-        m_numPlayers(0),
+        m_totalAbility(0),
         m_numGoalkeepers(0),
         m_numGames(0),
-        m_totalAbility(0),
+        m_id(0),
+        m_historyId(0),
+        m_lastMatch(MatchHistory::NO_MATCH),
         m_teamSpirit(),
-        m_players(nullptr)
+        m_numPlayers(0),
+        m_totalCards(0),
+        m_playerGames(0),
+        m_players(PlayerTable::NO_PLAYER),
+        m_rankKey(0),
+        m_slot(0)
 {}
 
 
 Team::~Team() {
-    m_players = nullptr;
+    m_players = PlayerTable::NO_PLAYER;
 }
 
 //-----------------------------------------------------Getters--------------------------------------------------
@@ -48,11 +60,11 @@ int Team::get_teamID() const  {
     return m_id;
 }
 
-Player* Team::get_allPlayers() const {
+int Team::get_allPlayers() const {
     return m_players;
 }   
 
-permutation_t Team::get_teamSpirit() const {
+Spirit Team::get_teamSpirit() const {
     return m_teamSpirit;
 }
 
@@ -64,10 +76,34 @@ int Team::get_score() const {
     return m_points + m_totalAbility;
 }
 
+int Team::get_total_cards() const {
+    return m_totalCards;
+}
+
+int Team::get_total_player_games() const {
+    return m_playerGames + m_numPlayers * m_numGames;
+}
+
 int Team::get_spirit_strength() const {
     return m_teamSpirit.strength();
 }
 
+int Team::get_rank_key() const {
+    return m_rankKey;
+}
+
+int Team::get_slot() const {
+    return m_slot;
+}
+
+int Team::get_history_id() const {
+    return m_historyId;
+}
+
+int Team::get_last_match() const {
+    return m_lastMatch;
+}
+
 //-------------------------------------Update Stats Functions----------------------------
 
 void Team::add_game() {
@@ -82,10 +118,30 @@ void Team::update_points_tie() {
     m_points += 1;
 }
 
-void Team::update_players(Player* player) {
+void Team::add_cards(const int cards) {
+    m_totalCards += cards;
+}
+
+void Team::update_players(const int player) {
     m_players = player;
 }
 
+void Team::update_rank_key(const int rankKey) {
+    m_rankKey = rankKey;
+}
+
+void Team::update_slot(const int slot) {
+    m_slot = slot;
+}
+
+void Team::update_history_id(const int historyId) {
+    m_historyId = historyId;
+}
+
+void Team::update_last_match(const int match) {
+    m_lastMatch = match;
+}
+
 //-------------------------------------Helper Functions for WorldCup----------------------------
 
 bool Team::is_valid() const{
@@ -96,8 +152,8 @@ bool Team::is_valid() const{
 }
 
 
-void Team::add_player(Player* player, const int id, const permutation_t& spirit, const int ability, 
-                                                                                const int cards, const bool goalkeeper){
+void Team::add_player(const Spirit& spirit, const int gamesPlayed, const int ability, const int cards,
+                                                                                            const bool goalkeeper){
     if (m_numPlayers == 0) {
         m_teamSpirit = spirit;
     }
@@ -105,6 +161,9 @@ void Team::add_player(Player* player, const int id, const permutation_t& spirit,
         m_teamSpirit = m_teamSpirit * spirit;
     }
     m_totalAbility += ability;
+    m_totalCards += cards;
+    //The player will also play every future game of the team, which get_total_player_games adds separately
+    m_playerGames += gamesPlayed - m_numGames;
     m_numPlayers++;
     if (goalkeeper) {
         m_numGoalkeepers++;
@@ -112,6 +171,25 @@ void Team::add_player(Player* player, const int id, const permutation_t& spirit,
 }
 
 
+void Team::add_players(const int numPlayers, const Spirit& spirit, const int gamesPlayed, const int ability,
+                       const int cards, const int goalkeepers) {
+    if (numPlayers == 0) {
+        return;
+    }
+    if (m_numPlayers == 0) {
+        m_teamSpirit = spirit;
+    }
+    else {
+        m_teamSpirit = m_teamSpirit * spirit;
+    }
+    m_totalAbility += ability;
+    m_totalCards += cards;
+    m_playerGames += gamesPlayed - numPlayers * m_numGames;
+    m_numPlayers += numPlayers;
+    m_numGoalkeepers += goalkeepers;
+}
+
+
 void Team::teams_unite(Team& bought) {
     if (m_numPlayers == 0) {
         m_teamSpirit = bought.m_teamSpirit;
@@ -120,8 +198,28 @@ void Team::teams_unite(Team& bought) {
             m_teamSpirit = m_teamSpirit * bought.m_teamSpirit;
     }
     m_points += bought.m_points;
+    //The games of both teams are folded into their players before m_numGames restarts
+    m_playerGames = get_total_player_games() + bought.get_total_player_games();
     m_numPlayers += bought.m_numPlayers;
     m_numGoalkeepers += bought.m_numGoalkeepers;
     m_numGames = 0;
     m_totalAbility += bought.m_totalAbility;
+    m_totalCards += bought.m_totalCards;
+}
+
+void Team::take_over(const Team& other, const int playerOffset, const int historyOffset, const int matchOffset) {
+    m_points = other.m_points;
+    m_totalAbility = other.m_totalAbility;
+    m_numGoalkeepers = other.m_numGoalkeepers;
+    m_numGames = other.m_numGames;
+    m_id = other.m_id;
+    m_historyId = other.m_historyId + historyOffset;
+    m_lastMatch = (other.m_lastMatch == MatchHistory::NO_MATCH) ? MatchHistory::NO_MATCH :
+                                                                  other.m_lastMatch + matchOffset;
+    m_teamSpirit = other.m_teamSpirit;
+    m_numPlayers = other.m_numPlayers;
+    m_totalCards = other.m_totalCards;
+    m_playerGames = other.m_playerGames;
+    m_players = (other.m_players == PlayerTable::NO_PLAYER) ? PlayerTable::NO_PLAYER : other.m_players + playerOffset;
+    m_rankKey = other.m_rankKey;
 }
@@ -1,12 +1,12 @@
 #ifndef TEAMS_H
 #define TEAMS_H
 
-class Player;
-
-#include "Player.h"
+#include "PlayerTable.h"
+#include "MatchHistory.h"
 #include "AVLTree.h"
 #include <memory>
 #include "wet2util.h"
+#include "Spirit.h"
 #include "AVLMultiTree.h"
 #include "GenericNode.h"
 
@@ -75,18 +75,18 @@ public:
     int get_teamID() const;
 
     /*
-    * Return the team's ID number
+    * Return the index of the root of the team's upside-down tree of players in the PlayerTable
     * @param - none
-    * @return - the team's ID number
+    * @return - the index of the root player, or PlayerTable::NO_PLAYER if the team has no players
     */
-    Player* get_allPlayers() const;
+    int get_allPlayers() const;
 
     /*
     * Return the team's ID number
     * @param - none
     * @return - the team's ID number
     */
-    permutation_t get_teamSpirit() const;
+    Spirit get_teamSpirit() const;
 
     /*
     * Return the team's ability
@@ -102,6 +102,20 @@ public:
     */
     int get_score() const;
 
+    /*
+    * Return the total number of cards the team's current players received
+    * @param - none
+    * @return - the total number of cards
+    */
+    int get_total_cards() const;
+
+    /*
+    * Return the sum of the number of games the team's current players played
+    * @param - none
+    * @return - the sum of the games
+    */
+    int get_total_player_games() const;
+
     /*
     * Return the team's spirit strength
     * @param - none
@@ -109,6 +123,34 @@ public:
     */
     int get_spirit_strength() const;
 
+    /*
+    * Return the position of the team's key in the offline ranks of world_cup (unused when running online)
+    * @param - none
+    * @return - the position of the team's key
+    */
+    int get_rank_key() const;
+
+    /*
+    * Return the team's slot in the team slots of world_cup (for the handles of the team)
+    * @param - none
+    * @return - the team's slot
+    */
+    int get_slot() const;
+
+    /*
+    * Return the team's history ID in the match history of world_cup
+    * @param - none
+    * @return - the team's history ID
+    */
+    int get_history_id() const;
+
+    /*
+    * Return the index of the team's last match in the match history of world_cup
+    * @param - none
+    * @return - the index of the match, or MatchHistory::NO_MATCH if the team has not played
+    */
+    int get_last_match() const;
+
     /*
     * Increase the number of games a team has played by 1 (used for play_match in world_cup)
     * @param - none
@@ -131,11 +173,46 @@ public:
     void update_points_tie();
 
     /*
-    * Updates the pointer to the upside-down tree of players in the team
-    * @param - pointer to the updated players tree root
+    * Updates the total number of cards after one of the team's players received cards
+    * @param - the number of new cards
+    * @return - void
+    */
+    void add_cards(const int cards);
+
+    /*
+    * Updates the root of the upside-down tree of players in the team
+    * @param - the index of the updated players tree root (PlayerTable::NO_PLAYER for no players)
     * @return - void
     */
-    void update_players(Player* player);
+    void update_players(const int player);
+
+    /*
+    * Updates the position of the team's key in the offline ranks of world_cup
+    * @param - the position of the team's current key
+    * @return - void
+    */
+    void update_rank_key(const int rankKey);
+
+    /*
+    * Updates the team's slot in the team slots of world_cup
+    * @param - the team's slot
+    * @return - void
+    */
+    void update_slot(const int slot);
+
+    /*
+    * Update the team's history ID in the match history
+    * @param - the history ID
+    * @return - void
+    */
+    void update_history_id(const int historyId);
+
+    /*
+    * Update the index of the team's last match in the match history
+    * @param - the index of the match
+    * @return - void
+    */
+    void update_last_match(const int match);
 
     /*
     * Checks whether or not a team has enough goalkeepers to be considered valid
@@ -147,10 +224,21 @@ public:
     /*
     * Helper function for add_player in world_cup:
     * Adds the player to the team and updates the team's stats accordingly
-    * @param - a pointer to the player to be added, its ID, goals, cards, and whether it is a goalkeeper
+    * @param - the player's spirit, number of games, ability, cards, and whether it is a goalkeeper
+    * @return - void
+    */
+    void add_player(const Spirit& spirit, const int gamesPlayed, const int ability, const int cards,
+                    const bool goalkeeper);
+
+    /*
+    * Helper function for add_players in world_cup:
+    * Adds several players to the team at once, with the same stats as adding them one by one
+    * @param - the number of players, the product of their spirits (in the order they join), and the sums of their
+    *          games, abilities and cards, and their number of goalkeepers
     * @return - void
     */
-    void add_player(Player* player, const int id, const permutation_t& spirit, const int ability, const int cards, const bool goalkeeper);
+    void add_players(const int numPlayers, const Spirit& spirit, const int gamesPlayed, const int ability,
+                     const int cards, const int goalkeepers);
 
     /*
     * Helper function for knockout in world_cup:
@@ -161,27 +249,50 @@ public:
     */
     void teams_unite(Team& bought);
 
+    /*
+    * Helper function for merge_from in world_cup:
+    * Take the stats of the same team in another world_cup, whose players and matches were moved after the ones of
+    *       this world_cup (so their indices are shifted by the given offsets). The team keeps its slot.
+    * @param - a reference to the other team, and the offsets of the indices of its players, its history ID and
+    *          its matches
+    * @return - void
+    */
+    void take_over(const Team& other, const int playerOffset, const int historyOffset, const int matchOffset);
+
 private:
 
     /*
-     * The internal fields of Team:
-     *   The team's ID
+     * The internal fields of Team, in the order they are used (a team is a single cache line in TeamSlots, and the
+     *       fields a match reads and writes come first):
      *   The number of points the team has
-     *   The number of players the team has
+     *   The total player ability of the players in the team
      *   The number of goalkeepers the team has
      *   The number of games the team has played
-     *   The total player ability of the players in the team
+     *   The team's ID
+     *   The team's history ID, and the index of its last match, in the match history
      *   The team's spirit
-     *   A pointer to the root of the upside-down tree that contains the team's players
+     *   The number of players the team has
+     *   The total number of cards of the players in the team
+     *   The sum of the games the players in the team played, not including the team's m_numGames games
+     *       (every player also played those, so the sum is m_playerGames + m_numPlayers * m_numGames)
+     *   The index of the root of the upside-down tree that contains the team's players
+     *   The position of the team's key in the offline ranks
+     *   The team's slot in the team slots
      */
-    int m_id;
     int m_points;
-    int m_numPlayers;
+    int m_totalAbility;
     int m_numGoalkeepers;
     int m_numGames;
-    int m_totalAbility;
-    permutation_t m_teamSpirit;
-    Player* m_players;
+    int m_id;
+    int m_historyId;
+    int m_lastMatch;
+    Spirit m_teamSpirit;
+    int m_numPlayers;
+    int m_totalCards;
+    int m_playerGames;
+    int m_players;
+    int m_rankKey;
+    int m_slot;
 
 };
 
@@ -0,0 +1,1204 @@
+//
+// Micro-benchmarks of the world_cup_t data structures.
+//
+// Build (not part of the submission, since it has its own main):
+//   g++ -std=c++11 -O2 -fno-delete-null-pointer-checks -o Benchmark mainBenchmark.cpp worldcup23a2.cpp
+//       Teams.cpp PlayerTable.cpp Spirit.cpp SpiritBatch.cpp RankFenwick.cpp RankKeyScanner.cpp FrozenSnapshot.cpp
+//       SeasonSimulator.cpp TeamSlots.cpp MatchHistory.cpp
+//
+// Run all of the benchmarks, or only the one given by name:
+//   ./Benchmark [offline_ranks | freeze | find_policies | spirit_batch | player_queries | team_export |
+//               union_find_paths | team_lookups | handles | consolidation | squads | team_cleanup | match_history |
+//               merge | team_pool | match_days | season]
+//
+
+#include "worldcup23a2.h"
+#include "RankKeyScanner.h"
+#include "SpiritBatch.h"
+#include "DriverUtils.h"
+#include <chrono>
+#include <iostream>
+#include <string>
+
+using namespace std;
+
+//----------------------------------------------Helpers------------------------------------------------
+
+static double elapsed_ms(chrono::steady_clock::time_point start)
+{
+    return chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+}
+
+static double ns_per_operation(const double ms, const long long numOperations)
+{
+    return ms * 1000000.0 / numOperations;
+}
+
+//-------------------------------------------Offline Ranks---------------------------------------------
+
+/*
+ * Replay a log of team/player additions mixed with get_ith_pointless_ability queries,
+ *      once online (rank tree) and once offline (pre-scan + Fenwick tree)
+ */
+static void benchmark_offline_ranks()
+{
+    const int numTeams = 100000;
+    const int numPlayers = 400000;
+    const int numQueries = 400000;
+    int* playerTeams = new int[numPlayers];
+    int* playerAbilities = new int[numPlayers];
+    permutation_t* spirits = new permutation_t[numPlayers];
+    int* queries = new int[numQueries];
+    for (int i = 0; i < numPlayers; i++) {
+        playerTeams[i] = 1 + next_random(numTeams);
+        playerAbilities[i] = next_random(2000) - 1000;
+        spirits[i] = random_spirit();
+    }
+    for (int i = 0; i < numQueries; i++) {
+        queries[i] = next_random(numTeams);
+    }
+    long long checksum[2] = {0, 0};
+    for (int offline = 0; offline <= 1; offline++) {
+        chrono::steady_clock::time_point start = chrono::steady_clock::now();
+        world_cup_t* obj = new world_cup_t();
+        if (offline) {
+            RankKeyScanner scanner;
+            for (int t = 1; t <= numTeams; t++) {
+                scanner.add_team(t);
+            }
+            for (int i = 0; i < numPlayers; i++) {
+                scanner.add_player(i + 1, playerTeams[i], spirits[i], 0, playerAbilities[i], 0);
+            }
+            obj->enable_offline_ranks(scanner.get_abilities(), scanner.get_team_ids(), scanner.get_num_keys());
+        }
+        for (int t = 1; t <= numTeams; t++) {
+            obj->add_team(t);
+        }
+        int query = 0;
+        for (int i = 0; i < numPlayers; i++) {
+            obj->add_player(i + 1, playerTeams[i], spirits[i], 0, playerAbilities[i], 0, false);
+            //One rank query after every player addition
+            if (query < numQueries) {
+                checksum[offline] += obj->get_ith_pointless_ability(queries[query++]).ans();
+            }
+        }
+        double total = elapsed_ms(start);
+        start = chrono::steady_clock::now();
+        for (int round = 0; round < 5; round++) {
+            for (int i = 0; i < numQueries; i++) {
+                checksum[offline] += obj->get_ith_pointless_ability(queries[i]).ans();
+            }
+        }
+        double queriesOnly = elapsed_ms(start);
+        delete obj;
+        cout << (offline ? "offline" : "online ") << " ranks: replay " << total << " ms, "
+             << 5 * numQueries << " rank queries " << queriesOnly << " ms" << endl;
+    }
+    print_results(checksum[0] == checksum[1]);
+
+    //The rank engines alone: re-key a team after every player addition, and answer one query per addition
+    int* teamAbilities = new int[numTeams + 1];
+    int* teamKeys = new int[numTeams + 1];
+    int* keyAbilities = new int[numTeams + numPlayers];
+    int* keyIds = new int[numTeams + numPlayers];
+    for (int t = 1; t <= numTeams; t++) {
+        teamAbilities[t] = 0;
+        keyAbilities[t - 1] = 0;
+        keyIds[t - 1] = t;
+    }
+    for (int i = 0; i < numPlayers; i++) {
+        teamAbilities[playerTeams[i]] += playerAbilities[i];
+        keyAbilities[numTeams + i] = teamAbilities[playerTeams[i]];
+        keyIds[numTeams + i] = playerTeams[i];
+    }
+    long long engineChecksum[2] = {0, 0};
+    for (int offline = 0; offline <= 1; offline++) {
+        Team** teams = new Team*[numTeams + 1];
+        for (int t = 1; t <= numTeams; t++) {
+            teams[t] = new Team(t);
+        }
+        MultiTree<Team*> tree;
+        chrono::steady_clock::time_point start = chrono::steady_clock::now();
+        RankFenwick* ranks = offline ? new RankFenwick(keyAbilities, keyIds, numTeams + numPlayers) : nullptr;
+        for (int t = 1; t <= numTeams; t++) {
+            teamAbilities[t] = 0;
+            if (offline) {
+                teamKeys[t] = ranks->next_key_position(t, 0);
+                ranks->insert(teamKeys[t]);
+            }
+            else {
+                tree.insert(teams[t], t, 0);
+            }
+        }
+        for (int i = 0; i < numPlayers; i++) {
+            int t = playerTeams[i];
+            if (offline) {
+                ranks->remove(teamKeys[t]);
+                teamAbilities[t] += playerAbilities[i];
+                teamKeys[t] = ranks->next_key_position(t, teamAbilities[t]);
+                ranks->insert(teamKeys[t]);
+                engineChecksum[offline] += ranks->find_index(queries[i % numQueries]);
+            }
+            else {
+                tree.remove(t, teamAbilities[t]);
+                teamAbilities[t] += playerAbilities[i];
+                tree.insert(teams[t], t, teamAbilities[t]);
+                engineChecksum[offline] += tree.find_index(tree.m_node, queries[i % numQueries])->get_data()->get_teamID();
+            }
+        }
+        double total = elapsed_ms(start);
+        delete ranks;
+        for (int t = 1; t <= numTeams; t++) {
+            delete teams[t];
+        }
+        delete[] teams;
+        cout << (offline ? "offline" : "online ") << " rank engine alone: " << total << " ms" << endl;
+    }
+    print_results(engineChecksum[0] == engineChecksum[1]);
+    delete[] teamAbilities;
+    delete[] teamKeys;
+    delete[] keyAbilities;
+    delete[] keyIds;
+    delete[] playerTeams;
+    delete[] playerAbilities;
+    delete[] spirits;
+    delete[] queries;
+}
+
+//-----------------------------------------------Freeze------------------------------------------------
+
+/*
+ * Answer the same read-only queries (team points, i'th team by ability, player cards) on the live structures,
+ *      and then on the snapshot built by freeze()
+ */
+static void benchmark_freeze()
+{
+    const int numTeams = 100000;
+    const int playersPerTeam = 4;
+    const int numPlayers = numTeams * playersPerTeam;
+    const int numQueries = 1000000;
+    world_cup_t* obj = new world_cup_t();
+    add_league(*obj, 1, numTeams, 1, playersPerTeam, 2000, 10);
+    int* teamQueries = new int[numQueries];
+    int* rankQueries = new int[numQueries];
+    int* playerQueries = new int[numQueries];
+    for (int i = 0; i < numQueries; i++) {
+        teamQueries[i] = 1 + next_random(numTeams);
+        rankQueries[i] = next_random(numTeams);
+        playerQueries[i] = 1 + next_random(numPlayers);
+    }
+    long long checksum[2] = {0, 0};
+    for (int frozen = 0; frozen <= 1; frozen++) {
+        if (frozen) {
+            chrono::steady_clock::time_point start = chrono::steady_clock::now();
+            obj->freeze();
+            cout << "freeze: " << elapsed_ms(start) << " ms" << endl;
+        }
+        chrono::steady_clock::time_point start = chrono::steady_clock::now();
+        for (int i = 0; i < numQueries; i++) {
+            checksum[frozen] += obj->get_team_points(teamQueries[i]).ans();
+        }
+        double points = elapsed_ms(start);
+        start = chrono::steady_clock::now();
+        for (int i = 0; i < numQueries; i++) {
+            checksum[frozen] += obj->get_ith_pointless_ability(rankQueries[i]).ans();
+        }
+        double ranks = elapsed_ms(start);
+        start = chrono::steady_clock::now();
+        for (int i = 0; i < numQueries; i++) {
+            checksum[frozen] += obj->get_player_cards(playerQueries[i]).ans();
+        }
+        double cards = elapsed_ms(start);
+        cout << (frozen ? "frozen" : "live  ") << ": " << numQueries << " get_team_points " << points << " ms, "
+             << numQueries << " get_ith_pointless_ability " << ranks << " ms, "
+             << numQueries << " get_player_cards " << cards << " ms" << endl;
+    }
+    print_results(checksum[0] == checksum[1]);
+    delete obj;
+    delete[] teamQueries;
+    delete[] rankQueries;
+    delete[] playerQueries;
+}
+
+//--------------------------------------------Find Policies--------------------------------------------
+
+/*
+ * Build the deepest upside-down trees that union by size allows (every buy_team unites two teams of the same
+ *      size, in rounds, so the trees are binomial trees of depth log(n)), with queries between the rounds,
+ *      and then query every player. Run once for every union-find policy.
+ */
+static void benchmark_find_policies()
+{
+    const int numTeams = 1 << 17;
+    const int numQueriesPerRound = 20000;
+    const FindPolicy policies[] = {FindPolicy::FULL_COMPRESSION, FindPolicy::PATH_HALVING,
+                                   FindPolicy::PATH_SPLITTING};
+    const char* names[] = {"full compression", "path halving    ", "path splitting  "};
+    long long checksum[3] = {0, 0, 0};
+    for (int p = 0; p < 3; p++) {
+        g_seed = 777;
+        world_cup_t* obj = new world_cup_t();
+        obj->set_find_policy(policies[p]);
+        add_league(*obj, 1, numTeams, 1, 1, 1, 1);
+        chrono::steady_clock::time_point start = chrono::steady_clock::now();
+        for (int step = 1; step < numTeams; step *= 2) {
+            for (int t = 1; t + step <= numTeams; t += 2 * step) {
+                obj->play_match(t, t + step);
+                obj->buy_team(t, t + step);
+            }
+            for (int i = 0; i < numQueriesPerRound; i++) {
+                checksum[p] += obj->num_played_games_for_player(1 + next_random(numTeams)).ans();
+            }
+        }
+        double unions = elapsed_ms(start);
+        obj->reset_union_find_stats();
+        start = chrono::steady_clock::now();
+        for (int round = 0; round < 2; round++) {
+            for (int i = numTeams; i >= 1; i--) {
+                checksum[p] += obj->num_played_games_for_player(i).ans();
+                checksum[p] += obj->get_partial_spirit(i).ans().strength();
+            }
+        }
+        double queries = elapsed_ms(start);
+        //The parent links that the finds of the queries followed (counted the same way for every policy)
+        const UnionFindStats& stats = obj->get_union_find_stats();
+        long long finds = 0;
+        long long links = 0;
+        for (int i = 0; i < UnionFindStats::NUM_BUCKETS; i++) {
+            finds += stats.findSteps[i];
+            links += i * stats.findSteps[i];
+        }
+        cout << names[p] << ": unions with queries " << unions << " ms, " << 4 * numTeams
+             << " queries on the united team " << queries << " ms, " << (double)links / finds
+             << " parent links per find" << endl;
+        delete obj;
+    }
+    print_results(checksum[0] == checksum[1] && checksum[0] == checksum[2]);
+}
+
+//---------------------------------------------Spirit Batch--------------------------------------------
+
+/*
+ * Compose the same arrays of independent permutations with permutation_t::operator*, with Spirit (table lookups),
+ *      and with compose_packed using each of its kernels
+ */
+static void benchmark_spirit_batch()
+{
+    const int count = 1000000;
+    const int rounds = 20;
+    permutation_t* first = new permutation_t[count];
+    permutation_t* second = new permutation_t[count];
+    permutation_t* composed = new permutation_t[count];
+    Spirit* firstSpirits = new Spirit[count];
+    Spirit* secondSpirits = new Spirit[count];
+    Spirit* composedSpirits = new Spirit[count];
+    unsigned char* firstPacked = new unsigned char[permutation_t::N * count];
+    unsigned char* secondPacked = new unsigned char[permutation_t::N * count];
+    unsigned char* composedPacked = new unsigned char[permutation_t::N * count];
+    for (int i = 0; i < count; i++) {
+        first[i] = random_spirit();
+        second[i] = random_spirit();
+        firstSpirits[i] = Spirit(first[i]);
+        secondSpirits[i] = Spirit(second[i]);
+        firstSpirits[i].to_packed(firstPacked + permutation_t::N * i);
+        secondSpirits[i].to_packed(secondPacked + permutation_t::N * i);
+    }
+    long long checksum = 0;
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    for (int round = 0; round < rounds; round++) {
+        for (int i = 0; i < count; i++) {
+            composed[i] = first[i] * second[i];
+        }
+    }
+    cout << "permutation_t operator*: " << elapsed_ms(start) << " ms" << endl;
+    for (int i = 0; i < count; i++) {
+        checksum += composed[i].strength();
+    }
+    long long spiritChecksum = 0;
+    start = chrono::steady_clock::now();
+    for (int round = 0; round < rounds; round++) {
+        for (int i = 0; i < count; i++) {
+            composedSpirits[i] = firstSpirits[i] * secondSpirits[i];
+        }
+    }
+    cout << "Spirit tables          : " << elapsed_ms(start) << " ms" << endl;
+    for (int i = 0; i < count; i++) {
+        spiritChecksum += composedSpirits[i].strength();
+    }
+    bool match = (checksum == spiritChecksum);
+    const PackedKernel kernels[] = {PackedKernel::SCALAR, PackedKernel::SSSE3, PackedKernel::AVX2};
+    const char* names[] = {"packed scalar          ", "packed SSSE3           ", "packed AVX2            "};
+    for (int k = 0; k < 3; k++) {
+        if (!packed_kernel_supported(kernels[k])) {
+            cout << names[k] << ": not supported" << endl;
+            continue;
+        }
+        start = chrono::steady_clock::now();
+        for (int round = 0; round < rounds; round++) {
+            compose_packed(firstPacked, secondPacked, composedPacked, count, kernels[k]);
+        }
+        cout << names[k] << ": " << elapsed_ms(start) << " ms" << endl;
+        long long packedChecksum = 0;
+        for (int i = 0; i < count; i++) {
+            packedChecksum += Spirit::from_packed(composedPacked + permutation_t::N * i).strength();
+        }
+        match = match && (checksum == packedChecksum);
+    }
+    cout << rounds << " x " << count << " compositions" << endl;
+    print_results(match);
+    delete[] first;
+    delete[] second;
+    delete[] composed;
+    delete[] firstSpirits;
+    delete[] secondSpirits;
+    delete[] composedSpirits;
+    delete[] firstPacked;
+    delete[] secondPacked;
+    delete[] composedPacked;
+}
+
+//--------------------------------------------Player Queries-------------------------------------------
+
+/*
+ * Latency of the union-find queries (num_played_games_for_player and get_partial_spirit) on a league of 1M
+ *      players, whose teams were united by a few rounds of buy_team
+ */
+static void benchmark_player_queries()
+{
+    const int numTeams = 1 << 16;
+    const int playersPerTeam = 16;
+    const int numPlayers = numTeams * playersPerTeam;
+    const int numQueries = 2000000;
+    g_seed = 4242;
+    world_cup_t* obj = new world_cup_t();
+    add_league(*obj, 1, numTeams, 1, playersPerTeam, 100, 1);
+    unite_in_pairs(*obj, numTeams, numTeams / 16);
+    int* queries = new int[numQueries];
+    for (int i = 0; i < numQueries; i++) {
+        queries[i] = 1 + next_random(numPlayers);
+    }
+    long long checksum = 0;
+    for (int round = 0; round < 2; round++) {
+        chrono::steady_clock::time_point start = chrono::steady_clock::now();
+        for (int i = 0; i < numQueries; i++) {
+            checksum += obj->num_played_games_for_player(queries[i]).ans();
+        }
+        double games = elapsed_ms(start);
+        start = chrono::steady_clock::now();
+        for (int i = 0; i < numQueries; i++) {
+            checksum += obj->get_partial_spirit(queries[i]).ans().strength();
+        }
+        double spirits = elapsed_ms(start);
+        cout << (round == 0 ? "first pass : " : "second pass: ")
+             << "num_played_games_for_player " << ns_per_operation(games, numQueries) << " ns, "
+             << "get_partial_spirit " << ns_per_operation(spirits, numQueries) << " ns per query" << endl;
+    }
+    cout << "checksum " << checksum << endl;
+    delete obj;
+    delete[] queries;
+}
+
+//--------------------------------------------Team Export----------------------------------------------
+
+/*
+ * Export the games and partial spirits of every player of a few large teams (built by chains of buy_team),
+ *      once with a pair of queries per player and once with export_team_players
+ */
+static void benchmark_team_export()
+{
+    const int numTeams = 1 << 12;
+    const int playersPerTeam = 64;
+    const int numPlayers = numTeams * playersPerTeam;
+    world_cup_t* worlds[2];
+    for (int w = 0; w < 2; w++) {
+        g_seed = 3838;
+        worlds[w] = new world_cup_t();
+        add_league(*worlds[w], 1, numTeams, 1, playersPerTeam, 1, 1);
+        //Only 16 teams of 16384 players are left
+        unite_in_pairs(*worlds[w], numTeams, 16);
+    }
+    int* ids = new int[numPlayers];
+    int* games = new int[numPlayers];
+    permutation_t* spirits = new permutation_t[numPlayers];
+    long long checksums[2] = {0, 0};
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    for (int t = 1; t <= numTeams; t += numTeams / 16) {
+        int numMembers = 0;
+        worlds[0]->for_each_player(t, [&](int playerId) { ids[numMembers++] = playerId; });
+        for (int i = 0; i < numMembers; i++) {
+            checksums[0] += worlds[0]->num_played_games_for_player(ids[i]).ans();
+            checksums[0] += worlds[0]->get_partial_spirit(ids[i]).ans().strength();
+        }
+    }
+    double perPlayer = elapsed_ms(start);
+    start = chrono::steady_clock::now();
+    for (int t = 1; t <= numTeams; t += numTeams / 16) {
+        int numMembers = worlds[1]->export_team_players(t, ids, games, spirits, numPlayers).ans();
+        for (int i = 0; i < numMembers; i++) {
+            checksums[1] += games[i] + spirits[i].strength();
+        }
+    }
+    double bulk = elapsed_ms(start);
+    cout << "per player queries: " << perPlayer << " ms, export_team_players: " << bulk << " ms ("
+         << numPlayers << " players)" << endl;
+    print_results(checksums[0] == checksums[1]);
+    delete worlds[0];
+    delete worlds[1];
+    delete[] ids;
+    delete[] games;
+    delete[] spirits;
+}
+
+//------------------------------------------Union-Find Paths-------------------------------------------
+
+/*
+ * Print the counters of the union-find: the distribution of find lengths, the compressions and the unions
+ */
+static void print_union_find_stats(const char* phase, const UnionFindStats& stats)
+{
+    long long finds = 0;
+    long long steps = 0;
+    int longest = 0;
+    for (int i = 0; i < UnionFindStats::NUM_BUCKETS; i++) {
+        finds += stats.findSteps[i];
+        steps += i * stats.findSteps[i];
+        if (stats.findSteps[i] != 0) {
+            longest = i;
+        }
+    }
+    int largestUnion = 0;
+    for (int i = 0; i < UnionFindStats::NUM_BUCKETS; i++) {
+        if (stats.unionSizes[i] != 0) {
+            largestUnion = i;
+        }
+    }
+    cout << "    " << phase << ": " << finds << " finds, mean " << (finds == 0 ? 0.0 : (double)steps / finds)
+         << " steps, longest " << longest << ", " << stats.compressions << " compressions, " << stats.unions
+         << " unions";
+    if (stats.unions != 0) {
+        cout << " (largest smaller side < 2^" << largestUnion + 1 << ")";
+    }
+    cout << endl;
+    cout << "    " << phase << " steps histogram:";
+    for (int i = 0; i <= longest; i++) {
+        cout << " " << stats.findSteps[i];
+    }
+    cout << endl;
+}
+
+/*
+ * Build the teams of 2^19 players with one of three buy_team patterns, and then query every player twice in
+ *      random order:
+ *   pairs       - teams of equal size buy each other, round after round (the deepest trees union by size allows)
+ *   small_into_large - a single large team buys the other teams one by one
+ *   large_into_small - every small team buys the large team (union by size still hangs the small tree)
+ */
+static void benchmark_union_find_paths()
+{
+    const int numPlayers = 1 << 19;
+    const int teamSize = 4;
+    const int numTeams = numPlayers / teamSize;
+    const char* patterns[3] = {"pairs", "small_into_large", "large_into_small"};
+    int* queries = new int[numPlayers];
+    for (int pattern = 0; pattern < 3; pattern++) {
+        g_seed = 4040;
+        world_cup_t* obj = new world_cup_t();
+        add_league(*obj, 1, numTeams, 1, teamSize, 1, 1);
+        chrono::steady_clock::time_point start = chrono::steady_clock::now();
+        if (pattern == 0) {
+            unite_in_pairs(*obj, numTeams, 1);
+        }
+        else if (pattern == 1) {
+            for (int t = 2; t <= numTeams; t++) {
+                obj->play_match(1, t);
+                obj->buy_team(1, t);
+            }
+        }
+        else {
+            for (int t = 2; t <= numTeams; t++) {
+                obj->play_match(t, t - 1);
+                obj->buy_team(t, t - 1);
+            }
+        }
+        double build = elapsed_ms(start);
+        for (int i = 0; i < numPlayers; i++) {
+            queries[i] = i + 1;
+        }
+        shuffle(queries, numPlayers);
+        const UnionFindStats buildStats = obj->get_union_find_stats();
+        cout << patterns[pattern] << ": build " << build << " ms" << endl;
+        print_union_find_stats("build", buildStats);
+        long long checksum = 0;
+        for (int round = 0; round < 2; round++) {
+            obj->reset_union_find_stats();
+            start = chrono::steady_clock::now();
+            for (int i = 0; i < numPlayers; i++) {
+                checksum += obj->num_played_games_for_player(queries[i]).ans();
+            }
+            double queryTime = elapsed_ms(start);
+            cout << "    query pass " << round + 1 << ": " << ns_per_operation(queryTime, numPlayers)
+                 << " ns per query" << endl;
+            print_union_find_stats(round == 0 ? "pass 1" : "pass 2", obj->get_union_find_stats());
+        }
+        cout << "    checksum " << checksum << endl;
+        delete obj;
+    }
+    delete[] queries;
+}
+
+//-------------------------------------------Team Lookups----------------------------------------------
+
+/*
+ * A mixed workload of searches of a single team by ID (get_team_points 40%, play_match 35%, add_player 20% and
+ *      buy_team 5%), on 10^5 and on 10^6 teams with random IDs, and with IDs (of the teams and the players) that are
+ *      multiples of 1024. Before them, the hash table alone: 10^5 inserts and finds of IDs with growing strides.
+ */
+static void benchmark_team_lookups()
+{
+    const int numIds = 100000;
+    const int strides[4] = {1, 64, 1024, 4096};
+    for (int s = 0; s < 4; s++) {
+        chrono::steady_clock::time_point start = chrono::steady_clock::now();
+        HashIndex<int> index;
+        long long checksum = 0;
+        for (int i = 1; i <= numIds; i++) {
+            index.insert(i * strides[s], i);
+        }
+        for (int i = 1; i <= numIds; i++) {
+            checksum += *index.find(i * strides[s]);
+        }
+        cout << "HashIndex, stride " << strides[s] << ": " << elapsed_ms(start) << " ms for " << numIds
+             << " inserts and finds (checksum " << checksum << ")" << endl;
+    }
+    const int numOps = 1 << 21;
+    const int sizes[2] = {100000, 1000000};
+    const int stride = 1024;
+    for (int pattern = 0; pattern < 2; pattern++) {
+        for (int s = 0; s < 2; s++) {
+            const int numTeams = sizes[s];
+            g_seed = 4343;
+            world_cup_t* obj = new world_cup_t();
+            int* teamIds = new int[numTeams];
+            for (int t = 0; t < numTeams; t++) {
+                teamIds[t] = (pattern == 0) ? 1 + next_random(1 << 30) : (t + 1) * stride;
+                obj->add_team(teamIds[t]);
+                obj->add_player((pattern == 0) ? t + 1 : (t + 1) * stride, teamIds[t], random_spirit(), 0,
+                                next_random(1000), 0, true);
+            }
+            int nextPlayer = numTeams + 1;
+            long long checksum = 0;
+            chrono::steady_clock::time_point start = chrono::steady_clock::now();
+            for (int i = 0; i < numOps; i++) {
+                int kind = next_random(20);
+                int team1 = teamIds[next_random(numTeams)];
+                int team2 = teamIds[next_random(numTeams)];
+                if (kind < 8) {
+                    checksum += obj->get_team_points(team1).ans();
+                }
+                else if (kind < 15) {
+                    checksum += obj->play_match(team1, team2).ans();
+                }
+                else if (kind < 19) {
+                    int playerId = (pattern == 0) ? nextPlayer : nextPlayer * stride + 1;
+                    nextPlayer++;
+                    checksum += (int)obj->add_player(playerId, team1, random_spirit(), 0, next_random(10), 0, false);
+                }
+                else {
+                    checksum += (int)obj->buy_team(team1, team2);
+                }
+            }
+            double total = elapsed_ms(start);
+            cout << numTeams << " teams, " << ((pattern == 0) ? "random" : "strided") << " IDs: "
+                 << ns_per_operation(total, numOps) << " ns per operation (checksum " << checksum << ")" << endl;
+            delete obj;
+            delete[] teamIds;
+        }
+    }
+}
+
+//----------------------------------------------Handles------------------------------------------------
+
+/*
+ * The same queries on 2^20 teams and players, once by ID and once by handles that the caller already holds
+ */
+static void benchmark_handles()
+{
+    const int numTeams = 1 << 20;
+    const int numOps = 1 << 21;
+    g_seed = 4444;
+    world_cup_t* obj = new world_cup_t();
+    TeamHandle* teams = new TeamHandle[numTeams + 1];
+    PlayerHandle* players = new PlayerHandle[numTeams + 1];
+    for (int t = 1; t <= numTeams; t++) {
+        obj->add_team(t, teams[t]);
+        obj->add_player(t, teams[t], random_spirit(), 0, next_random(1000), 0, true, players[t]);
+    }
+    //Every operation has the IDs, and the handles of the same team and players
+    int* ids1 = new int[numOps];
+    int* ids2 = new int[numOps];
+    TeamHandle* teamHandles = new TeamHandle[numOps];
+    PlayerHandle* playerHandles1 = new PlayerHandle[numOps];
+    PlayerHandle* playerHandles2 = new PlayerHandle[numOps];
+    for (int i = 0; i < numOps; i++) {
+        ids1[i] = 1 + next_random(numTeams);
+        ids2[i] = 1 + next_random(numTeams);
+        teamHandles[i] = teams[ids1[i]];
+        playerHandles1[i] = players[ids1[i]];
+        playerHandles2[i] = players[ids2[i]];
+    }
+    long long checksums[2] = {0, 0};
+    double times[2];
+    for (int round = 0; round < 2; round++) {
+        chrono::steady_clock::time_point start = chrono::steady_clock::now();
+        for (int i = 0; i < numOps; i++) {
+            if (round == 0) {
+                checksums[0] += obj->get_team_points(ids1[i]).ans() + obj->num_played_games_for_player(ids2[i]).ans();
+                checksums[0] += obj->get_partial_spirit(ids1[i]).ans().strength();
+            }
+            else {
+                checksums[1] += obj->get_team_points(teamHandles[i]).ans() +
+                                obj->num_played_games_for_player(playerHandles2[i]).ans();
+                checksums[1] += obj->get_partial_spirit(playerHandles1[i]).ans().strength();
+            }
+        }
+        times[round] = elapsed_ms(start);
+    }
+    cout << "by ID: " << ns_per_operation(times[0], numOps) << " ns, by handle: "
+         << ns_per_operation(times[1], numOps) << " ns per round of 3 queries" << endl;
+    print_results(checksums[0] == checksums[1]);
+    delete obj;
+    delete[] teams;
+    delete[] players;
+    delete[] ids1;
+    delete[] ids2;
+    delete[] teamHandles;
+    delete[] playerHandles1;
+    delete[] playerHandles2;
+}
+
+//-------------------------------------------Consolidation---------------------------------------------
+
+/*
+ * Merge 2^16 teams of 8 players into clubs of 32 teams, once with buy_team per team and once with buy_teams
+ */
+static void benchmark_consolidation()
+{
+    const int numTeams = 1 << 16;
+    const int playersPerTeam = 8;
+    const int clubSize = 32;
+    world_cup_t* worlds[2];
+    for (int w = 0; w < 2; w++) {
+        g_seed = 4545;
+        worlds[w] = new world_cup_t();
+        add_league(*worlds[w], 1, numTeams, 1, playersPerTeam, 100, 1);
+        play_random_matches(*worlds[w], 1, numTeams, numTeams);
+    }
+    int bought[clubSize];
+    double times[2];
+    for (int w = 0; w < 2; w++) {
+        chrono::steady_clock::time_point start = chrono::steady_clock::now();
+        for (int buyer = 1; buyer <= numTeams; buyer += clubSize) {
+            for (int i = 1; i < clubSize; i++) {
+                bought[i - 1] = buyer + i;
+            }
+            if (w == 0) {
+                for (int i = 0; i < clubSize - 1; i++) {
+                    worlds[0]->buy_team(buyer, bought[i]);
+                }
+            }
+            else {
+                worlds[1]->buy_teams(buyer, bought, clubSize - 1);
+            }
+        }
+        times[w] = elapsed_ms(start);
+    }
+    long long checksums[2] = {0, 0};
+    for (int w = 0; w < 2; w++) {
+        for (int p = 1; p <= numTeams * playersPerTeam; p += 7) {
+            checksums[w] += worlds[w]->num_played_games_for_player(p).ans();
+            checksums[w] += worlds[w]->get_partial_spirit(p).ans().strength();
+        }
+        for (int i = 0; i < numTeams / clubSize; i++) {
+            checksums[w] += worlds[w]->get_ith_pointless_ability(i).ans();
+        }
+    }
+    cout << "buy_team: " << times[0] << " ms, buy_teams: " << times[1] << " ms (" << numTeams / clubSize
+         << " clubs of " << clubSize << " teams)" << endl;
+    print_results(checksums[0] == checksums[1]);
+    delete worlds[0];
+    delete worlds[1];
+}
+
+//---------------------------------------------Squads--------------------------------------------------
+
+/*
+ * Register squads of 32 players for 2^15 teams, once with add_player per player and once with add_players
+ */
+static void benchmark_squads()
+{
+    const int numTeams = 1 << 15;
+    const int squadSize = 32;
+    PlayerSpec* squads = new PlayerSpec[numTeams * squadSize];
+    g_seed = 4646;
+    for (int i = 0; i < numTeams * squadSize; i++) {
+        squads[i].playerId = i + 1;
+        squads[i].spirit = random_spirit();
+        squads[i].gamesPlayed = next_random(5);
+        squads[i].ability = next_random(100);
+        squads[i].cards = next_random(3);
+        squads[i].goalKeeper = (i % squadSize == 0);
+    }
+    world_cup_t* worlds[2];
+    double times[2];
+    for (int w = 0; w < 2; w++) {
+        worlds[w] = new world_cup_t();
+        for (int t = 1; t <= numTeams; t++) {
+            worlds[w]->add_team(t);
+        }
+        chrono::steady_clock::time_point start = chrono::steady_clock::now();
+        for (int t = 1; t <= numTeams; t++) {
+            const PlayerSpec* squad = squads + (t - 1) * squadSize;
+            if (w == 0) {
+                for (int i = 0; i < squadSize; i++) {
+                    worlds[0]->add_player(squad[i].playerId, t, squad[i].spirit, squad[i].gamesPlayed,
+                                          squad[i].ability, squad[i].cards, squad[i].goalKeeper);
+                }
+            }
+            else {
+                worlds[1]->add_players(t, squad, squadSize);
+            }
+        }
+        times[w] = elapsed_ms(start);
+    }
+    long long checksums[2] = {0, 0};
+    for (int w = 0; w < 2; w++) {
+        for (int p = 1; p <= numTeams * squadSize; p += 5) {
+            checksums[w] += worlds[w]->get_partial_spirit(p).ans().strength();
+        }
+        for (int i = 0; i < numTeams; i += 7) {
+            checksums[w] += worlds[w]->get_ith_pointless_ability(i).ans();
+        }
+    }
+    cout << "add_player: " << times[0] << " ms, add_players: " << times[1] << " ms (" << numTeams << " squads of "
+         << squadSize << " players)" << endl;
+    print_results(checksums[0] == checksums[1]);
+    delete worlds[0];
+    delete worlds[1];
+    delete[] squads;
+}
+
+//-------------------------------------------Team Cleanup----------------------------------------------
+
+/*
+ * End-of-stage cleanups: remove a part of the teams (in a random order) one by one with remove_team, and at once with
+ *       remove_teams, which detaches the players together and rebuilds the trees of teams when many of them go
+ */
+static void benchmark_team_cleanup()
+{
+    const int numTeams = 1 << 16;
+    const int playersPerTeam = 4;
+    //The group stage keeps every 4th team, and the smaller cleanups remove every 4th or every 64th team
+    const int steps[] = {4, 4, 64};
+    const bool keepStep[] = {true, false, false};
+    int* removed = new int[numTeams];
+    for (int c = 0; c < 3; c++) {
+        int numRemoved = 0;
+        for (int t = 1; t <= numTeams; t++) {
+            if ((t % steps[c] == 0) != keepStep[c]) {
+                removed[numRemoved++] = t;
+            }
+        }
+        g_seed = 4747;
+        shuffle(removed, numRemoved);
+        //Every world is built, cleaned up and checked before the next one is built, so that both start from the same
+        //state of the heap
+        double times[2];
+        long long checksums[2] = {0, 0};
+        for (int w = 0; w < 2; w++) {
+            g_seed = 4748;
+            world_cup_t* world = new world_cup_t();
+            add_league(*world, 1, numTeams, 1, playersPerTeam, 100, 1);
+            play_random_matches(*world, 1, numTeams, numTeams);
+            chrono::steady_clock::time_point start = chrono::steady_clock::now();
+            if (w == 0) {
+                for (int i = 0; i < numRemoved; i++) {
+                    world->remove_team(removed[i]);
+                }
+            }
+            else {
+                world->remove_teams(removed, numRemoved);
+            }
+            times[w] = elapsed_ms(start);
+            for (int p = 1; p <= numTeams * playersPerTeam; p += 7) {
+                checksums[w] += world->num_played_games_for_player(p).ans();
+            }
+            int remaining = numTeams - numRemoved;
+            for (int i = 0; i < remaining; i += 5) {
+                checksums[w] += world->get_ith_pointless_ability(i).ans();
+                checksums[w] += world->get_ith_team_by_score(i).ans();
+            }
+            checksums[w] += world->knockout_winner(1, numTeams).ans();
+            delete world;
+        }
+        cout << "remove " << numRemoved << " of " << numTeams << " teams: remove_team: " << times[0]
+             << " ms, remove_teams: " << times[1] << " ms" << endl;
+        print_results(checksums[0] == checksums[1]);
+    }
+    delete[] removed;
+}
+
+
+//--------------------------------------------Match History--------------------------------------------
+
+/*
+ * The cost of recording a match in MatchHistory, and the head-to-head records from the indexed table against
+ *       walking the whole history of the first team
+ */
+static void benchmark_match_history()
+{
+    //Recording alone, on a few teams outside of a world (in play_match the teams are already in the cache). A short
+    //log is filled again and again, so that its memory stays in the cache, and the pairs of teams are drawn in advance
+    const int numTeams = 1 << 6;
+    const int numRecords = 1 << 12;
+    const int numRepeats = 1 << 12;
+    Team** teams = new Team*[numTeams];
+    int* firsts = new int[numRecords];
+    int* seconds = new int[numRecords];
+    g_seed = 4848;
+    for (int i = 0; i < numRecords; i++) {
+        firsts[i] = next_random(numTeams);
+        seconds[i] = (firsts[i] + 1 + next_random(numTeams - 1)) % numTeams;
+    }
+    double recordTime = 0;
+    for (int r = 0; r < numRepeats; r++) {
+        MatchHistory* history = new MatchHistory();
+        for (int t = 0; t < numTeams; t++) {
+            teams[t] = new Team(t + 1);
+            teams[t]->update_history_id(history->add_team(t + 1));
+        }
+        history->reserve(numRecords);
+        chrono::steady_clock::time_point start = chrono::steady_clock::now();
+        for (int i = 0; i < numRecords; i++) {
+            history->record(teams[firsts[i]], teams[seconds[i]], i % 5, i, -i);
+        }
+        recordTime += elapsed_ms(start);
+        for (int t = 0; t < numTeams; t++) {
+            delete teams[t];
+        }
+        delete history;
+    }
+    cout << "record: " << ns_per_operation(recordTime, (long long)numRecords * numRepeats) << " ns per match" << endl;
+    delete[] teams;
+    delete[] firsts;
+    delete[] seconds;
+
+    //Head-to-head queries on a world
+    const int numWorldTeams = 1 << 10;
+    const int numMatches = 1 << 20;
+    const int numQueries = 1 << 14;
+    world_cup_t* world = new world_cup_t();
+    g_seed = 4849;
+    add_league(*world, 1, numWorldTeams, 1, 1, 1000, 1);
+    int* teamIds1 = new int[numMatches];
+    int* teamIds2 = new int[numMatches];
+    int* results = new int[numMatches];
+    StatusType* statuses = new StatusType[numMatches];
+    random_team_ids(teamIds1, numMatches, numWorldTeams);
+    random_team_ids(teamIds2, numMatches, numWorldTeams);
+    world->play_matches(teamIds1, teamIds2, numMatches, results, statuses);
+    MatchRecord* matches = new MatchRecord[numMatches];
+    long long checksums[2] = {0, 0};
+    double times[2];
+    for (int w = 0; w < 2; w++) {
+        g_seed = 4850;
+        chrono::steady_clock::time_point start = chrono::steady_clock::now();
+        for (int i = 0; i < numQueries; i++) {
+            int team1 = 1 + next_random(numWorldTeams);
+            int team2 = 1 + (team1 + next_random(numWorldTeams - 1)) % numWorldTeams;
+            if (w == 0) {
+                int numPlayed = world->get_last_matches(team1, numMatches, matches).ans();
+                for (int j = 0; j < numPlayed; j++) {
+                    if (matches[j].opponentId == team2) {
+                        checksums[0] += (matches[j].result == 0) ? 1 : (matches[j].result <= 2 ? 1000 : 1000000);
+                    }
+                }
+            }
+            else {
+                HeadToHead record;
+                world->get_head_to_head(team1, team2, record);
+                checksums[1] += record.ties + 1000LL * record.wins + 1000000LL * record.losses;
+            }
+        }
+        times[w] = elapsed_ms(start);
+    }
+    cout << "head to head: " << times[0] << " ms walking the history, " << times[1] << " ms indexed (" << numQueries
+         << " queries after " << numMatches << " matches)" << endl;
+    print_results(checksums[0] == checksums[1]);
+    delete world;
+    delete[] teamIds1;
+    delete[] teamIds2;
+    delete[] results;
+    delete[] statuses;
+    delete[] matches;
+}
+
+
+//-----------------------------------------------Merge-------------------------------------------------
+
+/*
+ * The league of a region: its teams (every region's team IDs are t*numRegions - region), their players, a match day
+ *       and a round of buys, always the same for the same region
+ */
+static void play_region(world_cup_t* world, const int region, const int numRegions, const int numTeams,
+                        const int playersPerTeam)
+{
+    g_seed = 5050 + region;
+    for (int t = 1; t <= numTeams; t++) {
+        int teamId = t * numRegions - region;
+        world->add_team(teamId);
+        for (int p = 0; p < playersPerTeam; p++) {
+            world->add_player(((t - 1) * playersPerTeam + p) * numRegions + region + 1, teamId, random_spirit(),
+                              next_random(5), next_random(100), next_random(3), p == 0);
+        }
+    }
+    for (int i = 0; i < numTeams; i++) {
+        world->play_match((1 + next_random(numTeams)) * numRegions - region,
+                          (1 + next_random(numTeams)) * numRegions - region);
+    }
+    for (int i = 0; i < numTeams / 8; i++) {
+        world->buy_team((1 + next_random(numTeams)) * numRegions - region,
+                        (1 + next_random(numTeams)) * numRegions - region);
+    }
+}
+
+
+/*
+ * Merge a regional league into the national one: replaying the region's adds, matches and buys into the national
+ *       world_cup, against building the region on its own and moving it with merge_from
+ */
+static void benchmark_merge()
+{
+    const int numTeams = 1 << 16;
+    const int playersPerTeam = 8;
+    //Every world is built, merged and checked before the next one is built, so that both start from the same state
+    //of the heap
+    double times[2] = {0, 0};
+    long long checksums[2] = {0, 0};
+    for (int w = 0; w < 2; w++) {
+        world_cup_t* national = new world_cup_t();
+        play_region(national, 0, 2, numTeams, playersPerTeam);
+        if (w == 0) {
+            chrono::steady_clock::time_point start = chrono::steady_clock::now();
+            play_region(national, 1, 2, numTeams, playersPerTeam);
+            times[w] = elapsed_ms(start);
+        }
+        else {
+            world_cup_t* regional = new world_cup_t();
+            play_region(regional, 1, 2, numTeams, playersPerTeam);
+            chrono::steady_clock::time_point start = chrono::steady_clock::now();
+            national->merge_from(static_cast<world_cup_t&&>(*regional));
+            times[w] = elapsed_ms(start);
+            delete regional;
+        }
+        for (int p = 1; p <= 2 * numTeams * playersPerTeam; p += 7) {
+            checksums[w] += national->num_played_games_for_player(p).ans();
+            checksums[w] += national->get_player_cards(p).ans();
+        }
+        for (int t = 1; t <= 2 * numTeams; t += 3) {
+            checksums[w] += national->get_team_points(t).ans();
+        }
+        for (int i = 0; i < 2 * numTeams; i += 5) {
+            checksums[w] += national->get_ith_pointless_ability(i).ans();
+            checksums[w] += national->get_ith_team_by_score(i).ans();
+        }
+        checksums[w] += national->knockout_winner(1, 2 * numTeams).ans();
+        delete national;
+    }
+    cout << "merge " << numTeams << " teams of " << playersPerTeam << " players into " << numTeams
+         << " teams: replay: " << times[0] << " ms, merge_from: " << times[1] << " ms" << endl;
+    print_results(checksums[0] == checksums[1]);
+}
+
+
+//---------------------------------------------Team Pool-----------------------------------------------
+
+/*
+ * play_match on teams that were added and removed over time (so that their memory is not in the order of the
+ *       IDs), with players added in between
+ */
+static void benchmark_team_pool()
+{
+    const int numTeams = 1 << 17;
+    const int numMatches = 1 << 20;
+    g_seed = 4949;
+    world_cup_t* world = new world_cup_t();
+    add_league(*world, 1, numTeams, 1, 1, 1000, 1);
+    int nextPlayer = numTeams + 1;
+    //Replace a random half of the teams with new ones
+    for (int i = 0; i < numTeams / 2; i++) {
+        int teamId = 1 + next_random(numTeams);
+        if (world->remove_team(teamId) == StatusType::SUCCESS) {
+            world->add_team(teamId);
+            world->add_player(nextPlayer++, teamId, random_spirit(), 0, next_random(1000), 0, true);
+        }
+    }
+    int* teamIds1 = new int[numMatches];
+    int* teamIds2 = new int[numMatches];
+    random_team_ids(teamIds1, numMatches, numTeams);
+    random_team_ids(teamIds2, numMatches, numTeams);
+    long long checksum = 0;
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    for (int i = 0; i < numMatches; i++) {
+        output_t<int> result = world->play_match(teamIds1[i], teamIds2[i]);
+        checksum += (result.status() == StatusType::SUCCESS) ? result.ans() : -1;
+    }
+    double time = elapsed_ms(start);
+    cout << "play_match: " << ns_per_operation(time, numMatches) << " ns per match (" << numTeams << " teams, checksum "
+         << checksum << ")" << endl;
+    delete world;
+    delete[] teamIds1;
+    delete[] teamIds2;
+}
+
+
+//---------------------------------------------Match Days----------------------------------------------
+
+/*
+ * Play match days of 2^20 matches between 2^17 teams, once with play_match per match and once with play_matches
+ */
+static void benchmark_match_days()
+{
+    const int numTeams = 1 << 17;
+    const int numMatches = 1 << 20;
+    int* teamIds1 = new int[numMatches];
+    int* teamIds2 = new int[numMatches];
+    int* results = new int[numMatches];
+    StatusType* statuses = new StatusType[numMatches];
+    world_cup_t* worlds[2];
+    for (int w = 0; w < 2; w++) {
+        g_seed = 4141;
+        worlds[w] = new world_cup_t();
+        add_league(*worlds[w], 1, numTeams, 1, 1, 1000, 1);
+    }
+    random_team_ids(teamIds1, numMatches, numTeams);
+    random_team_ids(teamIds2, numMatches, numTeams);
+    long long checksums[2] = {0, 0};
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    for (int i = 0; i < numMatches; i++) {
+        output_t<int> result = worlds[0]->play_match(teamIds1[i], teamIds2[i]);
+        checksums[0] += (result.status() == StatusType::SUCCESS) ? result.ans() : -1;
+    }
+    double single = elapsed_ms(start);
+    start = chrono::steady_clock::now();
+    worlds[1]->play_matches(teamIds1, teamIds2, numMatches, results, statuses);
+    double batch = elapsed_ms(start);
+    for (int i = 0; i < numMatches; i++) {
+        checksums[1] += results[i];
+    }
+    for (int i = 0; i < numTeams; i += 997) {
+        checksums[0] += worlds[0]->get_ith_team_by_score(i).ans();
+        checksums[1] += worlds[1]->get_ith_team_by_score(i).ans();
+    }
+    cout << "play_match: " << single << " ms, play_matches: " << batch << " ms (" << numMatches << " matches)"
+         << endl;
+    print_results(checksums[0] == checksums[1]);
+    delete worlds[0];
+    delete worlds[1];
+    delete[] teamIds1;
+    delete[] teamIds2;
+    delete[] results;
+    delete[] statuses;
+}
+
+//-----------------------------------------------Season------------------------------------------------
+
+/*
+ * Simulate a round-robin season of 2^12 teams, once with the scalar kernel and once with the SSE2 kernel
+ */
+static void benchmark_season()
+{
+    const int numTeams = 1 << 12;
+    g_seed = 4242;
+    world_cup_t* world = new world_cup_t();
+    add_league(*world, 1, numTeams, 1, 11, 100, 1);
+    int* teamIds[2] = {new int[numTeams], new int[numTeams]};
+    int* points[2] = {new int[numTeams], new int[numTeams]};
+    SeasonKernel kernels[2] = {SeasonKernel::SCALAR, SeasonKernel::SSE2};
+    double times[2];
+    for (int k = 0; k < 2; k++) {
+        chrono::steady_clock::time_point start = chrono::steady_clock::now();
+        world->simulate_season(teamIds[k], points[k], numTeams, kernels[k]);
+        times[k] = elapsed_ms(start);
+    }
+    bool same = true;
+    for (int i = 0; i < numTeams; i++) {
+        same = same && teamIds[0][i] == teamIds[1][i] && points[0][i] == points[1][i];
+    }
+    cout << "season scalar: " << times[0] << " ms, sse2: " << times[1] << " ms ("
+         << (long long)numTeams * (numTeams - 1) / 2 << " matches)" << endl;
+    print_results(same);
+    delete world;
+    for (int k = 0; k < 2; k++) {
+        delete[] teamIds[k];
+        delete[] points[k];
+    }
+}
+
+//-----------------------------------------------Main--------------------------------------------------
+
+int main(int argc, char** argv)
+{
+    string which = (argc > 1) ? argv[1] : "all";
+    if (which == "all" || which == "offline_ranks") {
+        benchmark_offline_ranks();
+    }
+    if (which == "all" || which == "freeze") {
+        benchmark_freeze();
+    }
+    if (which == "all" || which == "find_policies") {
+        benchmark_find_policies();
+    }
+    if (which == "all" || which == "spirit_batch") {
+        benchmark_spirit_batch();
+    }
+    if (which == "all" || which == "player_queries") {
+        benchmark_player_queries();
+    }
+    if (which == "all" || which == "team_export") {
+        benchmark_team_export();
+    }
+    if (which == "all" || which == "union_find_paths") {
+        benchmark_union_find_paths();
+    }
+    if (which == "all" || which == "team_lookups") {
+        benchmark_team_lookups();
+    }
+    if (which == "all" || which == "handles") {
+        benchmark_handles();
+    }
+    if (which == "all" || which == "consolidation") {
+        benchmark_consolidation();
+    }
+    if (which == "all" || which == "squads") {
+        benchmark_squads();
+    }
+    if (which == "all" || which == "team_cleanup") {
+        benchmark_team_cleanup();
+    }
+    if (which == "all" || which == "match_history") {
+        benchmark_match_history();
+    }
+    if (which == "all" || which == "merge") {
+        benchmark_merge();
+    }
+    if (which == "all" || which == "team_pool") {
+        benchmark_team_pool();
+    }
+    if (which == "all" || which == "match_days") {
+        benchmark_match_days();
+    }
+    if (which == "all" || which == "season") {
+        benchmark_season();
+    }
+    return 0;
+}
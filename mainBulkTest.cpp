@@ -0,0 +1,283 @@
+//
+// Regression tests of the bulk operations of world_cup_t (merge_from, buy_teams, remove_teams) and of the match log.
+//
+// Every bulk operation is documented to have the same result as a sequence of single operations, so every test
+// runs the bulk operation on one world_cup and the single operations on another, and compares all of the queries
+// of the two. The process exits with 1 if any check fails.
+//
+// Build (not part of the submission, since it has its own main):
+//   g++ -std=c++11 -Wall -o BulkTester mainBulkTest.cpp worldcup23a2.cpp Teams.cpp PlayerTable.cpp Spirit.cpp
+//       SpiritBatch.cpp RankFenwick.cpp RankKeyScanner.cpp FrozenSnapshot.cpp SeasonSimulator.cpp TeamSlots.cpp
+//       MatchHistory.cpp
+//
+
+#include "worldcup23a2.h"
+#include "DriverUtils.h"
+#include <iostream>
+
+using namespace std;
+
+//----------------------------------------------Helpers------------------------------------------------
+
+/*
+ * Add a league (see add_league) with abilities in [0, 200) and cards in [0, 4), play matches between its teams,
+ *      and give cards to its players
+ */
+static void play_league(world_cup_t& world, int firstTeam, int numTeams, int firstPlayer, int playersPerTeam,
+                        unsigned int seed)
+{
+    g_seed = seed;
+    add_league(world, firstTeam, numTeams, firstPlayer, playersPerTeam, 200, 4);
+    play_random_matches(world, firstTeam, firstTeam + numTeams - 1, numTeams * 3);
+    for (int i = 0; i < numTeams; i++) {
+        world.add_player_cards(firstPlayer + next_random(numTeams * playersPerTeam), next_random(3));
+    }
+}
+
+/*
+ * Play the same random matches between the teams in [firstTeam, lastTeam] in two worlds
+ */
+static void play_matches(world_cup_t& world, world_cup_t& expected, int firstTeam, int lastTeam, int numMatches,
+                         unsigned int seed)
+{
+    g_seed = seed;
+    play_random_matches(world, firstTeam, lastTeam, numMatches);
+    g_seed = seed;
+    play_random_matches(expected, firstTeam, lastTeam, numMatches);
+}
+
+//----------------------------------------------Merge------------------------------------------------
+
+/*
+ * The other world's changes after its league: teams that are bought and teams that are removed (one by one and
+ *      together), and more matches between the teams that are left
+ */
+static void change_other_world(world_cup_t& world)
+{
+    world.buy_team(101, 102);
+    const int bought[] = {105, 106};
+    world.buy_teams(104, bought, 2);
+    world.remove_team(110);
+    const int removed[] = {111, 113};
+    world.remove_teams(removed, 2);
+    g_seed = 77;
+    play_random_matches(world, 101, 120, 40);
+}
+
+static void test_merge_from()
+{
+    const char* test = "merge_from";
+    //The expected world replays the operations of both worlds
+    world_cup_t world;
+    world_cup_t other;
+    world_cup_t expected;
+    play_league(world, 1, 30, 1, 3, 11);
+    play_league(expected, 1, 30, 1, 3, 11);
+    play_league(other, 101, 20, 1001, 3, 22);
+    play_league(expected, 101, 20, 1001, 3, 22);
+    change_other_world(other);
+    change_other_world(expected);
+
+    //Handles of the other world, taken before the merge
+    output_t<TeamHandle> oldTeam = other.resolve_team(101);
+    output_t<PlayerHandle> oldPlayer = other.resolve_player(1001);
+    check(oldTeam.status() == StatusType::SUCCESS && oldPlayer.status() == StatusType::SUCCESS, test, "resolve");
+
+    check(world.merge_from(std::move(world)) == StatusType::INVALID_INPUT, test, "merge into itself");
+    check(world.merge_from(std::move(other)) == StatusType::SUCCESS, test, "merge");
+    compare_worlds(world, expected, 120, 1060, test);
+
+    //The other world is left empty
+    world_cup_t empty;
+    compare_worlds(other, empty, 120, 1060, test);
+
+    //The IDs of the bought and removed teams are free again, but the players of the removed teams still exist
+    check(world.add_team(102) == StatusType::SUCCESS && expected.add_team(102) == StatusType::SUCCESS, test,
+          "add a bought team's ID");
+    check(world.add_team(110) == StatusType::SUCCESS && expected.add_team(110) == StatusType::SUCCESS, test,
+          "add a removed team's ID");
+    check(world.add_player(1028, 110, permutation_t::neutral(), 0, 0, 0, true) == StatusType::FAILURE, test,
+          "add a player of a removed team");
+    play_matches(world, expected, 1, 120, 200, 33);
+    compare_worlds(world, expected, 120, 1060, test);
+
+    //A player of a removed team in the other world collides with a player of this world
+    world_cup_t colliding;
+    colliding.add_team(200);
+    colliding.add_player(1029, 200, permutation_t::neutral(), 0, 0, 0, true);
+    colliding.remove_team(200);
+    check(world.merge_from(std::move(colliding)) == StatusType::FAILURE, test, "player ID in both worlds");
+    compare_worlds(world, expected, 120, 1060, test);
+
+    //The emptied world is used again, and merged into the world once more
+    play_league(other, 201, 10, 2001, 2, 44);
+    play_league(expected, 201, 10, 2001, 2, 44);
+    check(world.merge_from(std::move(other)) == StatusType::SUCCESS, test, "merge the emptied world again");
+    compare_worlds(world, expected, 210, 2020, test);
+
+    //The handles taken before the first merge are not valid in either world, even though the emptied world gave
+    //  their slot and index to new teams and players
+    play_league(other, 301, 4, 3001, 2, 55);
+    int newCards = other.get_player_cards(3001).ans();
+    check(other.get_team_points(oldTeam.ans()).status() == StatusType::FAILURE, test, "old team handle");
+    check(other.num_played_games_for_player(oldPlayer.ans()).status() == StatusType::FAILURE, test,
+          "old player handle");
+    check(other.add_player_cards(oldPlayer.ans(), 1) == StatusType::FAILURE, test, "old player handle");
+    check(other.get_player_cards(oldPlayer.ans()).status() == StatusType::FAILURE, test, "old player handle");
+    check(other.get_partial_spirit(oldPlayer.ans()).status() == StatusType::FAILURE, test, "old player handle");
+    check(world.get_player_cards(oldPlayer.ans()).status() == StatusType::FAILURE, test, "old player handle");
+    check(same_output(other.get_player_cards(3001), output_t<int>(newCards)), test, "cards of the new player");
+}
+
+//---------------------------------------------Buy Teams----------------------------------------------
+
+static void test_buy_teams()
+{
+    const char* test = "buy_teams";
+    world_cup_t world;
+    world_cup_t expected;
+    play_league(world, 1, 30, 1, 3, 45);
+    play_league(expected, 1, 30, 1, 3, 45);
+    //Teams of different sizes, so that the largest tree (which keeps its root) is in the middle of the buys
+    world.buy_team(10, 11);
+    expected.buy_team(10, 11);
+    world.buy_team(10, 12);
+    expected.buy_team(10, 12);
+    world.add_team(31);
+    expected.add_team(31);
+
+    //A missing or repeating team fails the whole buy
+    const int missing[] = {2, 40};
+    check(world.buy_teams(1, missing, 2) == StatusType::FAILURE, test, "missing team");
+    const int repeating[] = {2, 3, 2};
+    check(world.buy_teams(1, repeating, 3) == StatusType::FAILURE, test, "repeating team");
+    compare_worlds(world, expected, 31, 90, test);
+
+    //The same as buying the teams one by one, in order (with an empty team among them)
+    const int bought[] = {5, 10, 31, 3, 20};
+    const int numBought = sizeof(bought) / sizeof(bought[0]);
+    check(world.buy_teams(1, bought, numBought) == StatusType::SUCCESS, test, "buy");
+    for (int i = 0; i < numBought; i++) {
+        expected.buy_team(1, bought[i]);
+    }
+    compare_worlds(world, expected, 31, 90, test);
+
+    //An empty buyer, and then more matches and buys of the united team
+    world.add_team(32);
+    expected.add_team(32);
+    const int more[] = {6, 1, 7};
+    check(world.buy_teams(32, more, 3) == StatusType::SUCCESS, test, "buy into an empty team");
+    for (int i = 0; i < 3; i++) {
+        expected.buy_team(32, more[i]);
+    }
+    play_matches(world, expected, 1, 32, 60, 46);
+    world.buy_team(32, 8);
+    expected.buy_team(32, 8);
+    compare_worlds(world, expected, 32, 90, test);
+}
+
+//-------------------------------------------Remove Teams---------------------------------------------
+
+static void test_remove_teams()
+{
+    const char* test = "remove_teams";
+    world_cup_t world;
+    world_cup_t expected;
+    play_league(world, 1, 40, 1, 2, 55);
+    play_league(expected, 1, 40, 1, 2, 55);
+
+    //A repeating ID fails the whole removal
+    const int repeating[] = {3, 5, 3};
+    check(world.remove_teams(repeating, 3) == StatusType::FAILURE, test, "repeating ID");
+    compare_worlds(world, expected, 40, 80, test);
+
+    //Two teams of 40 are removed one by one from the trees
+    const int few[] = {7, 2};
+    check(world.remove_teams(few, 2) == StatusType::SUCCESS, test, "remove a few teams");
+    expected.remove_team(7);
+    expected.remove_team(2);
+    compare_worlds(world, expected, 40, 80, test);
+
+    //12 teams of 38 are at least one in REBUILD_RATIO (4), so the trees are rebuilt from the remaining teams
+    const int many[] = {38, 1, 20, 13, 9, 30, 31, 4, 25, 17, 40, 11};
+    const int numMany = sizeof(many) / sizeof(many[0]);
+    check(world.remove_teams(many, numMany) == StatusType::SUCCESS, test, "remove many teams");
+    for (int i = 0; i < numMany; i++) {
+        expected.remove_team(many[i]);
+    }
+    compare_worlds(world, expected, 40, 80, test);
+
+    //The rebuilt trees keep working: teams are added, play, buy, and are removed again
+    play_league(world, 41, 10, 81, 2, 66);
+    play_league(expected, 41, 10, 81, 2, 66);
+    world.buy_team(41, 3);
+    expected.buy_team(41, 3);
+    play_matches(world, expected, 1, 50, 100, 88);
+    compare_worlds(world, expected, 50, 100, test);
+
+    //All of the remaining teams are removed at once
+    int remaining[50];
+    int numRemaining = 0;
+    for (int teamId = 1; teamId <= 50; teamId++) {
+        if (expected.get_team_points(teamId).status() == StatusType::SUCCESS) {
+            remaining[numRemaining++] = teamId;
+        }
+    }
+    check(world.remove_teams(remaining, numRemaining) == StatusType::SUCCESS, test, "remove all teams");
+    for (int i = 0; i < numRemaining; i++) {
+        expected.remove_team(remaining[i]);
+    }
+    compare_worlds(world, expected, 50, 100, test);
+}
+
+//-------------------------------------------Last Matches---------------------------------------------
+
+static void test_last_matches_across_buy()
+{
+    const char* test = "get_last_matches";
+    world_cup_t world;
+    play_league(world, 1, 3, 1, 1, 99);
+    MatchRecord before[8];
+    output_t<int> numBefore = world.get_last_matches(1, 8, before);
+    check(numBefore.status() == StatusType::SUCCESS, test, "matches before the buy");
+
+    //The buyer keeps only its own matches, and the bought team's ID has no matches
+    check(world.buy_team(1, 2) == StatusType::SUCCESS, test, "buy");
+    MatchRecord after[8];
+    output_t<int> numAfter = world.get_last_matches(1, 8, after);
+    check(same_output(numAfter, numBefore), test, "the buyer's matches after the buy");
+    for (int i = 0; i < numBefore.ans() && i < numAfter.ans(); i++) {
+        check(after[i].opponentId == before[i].opponentId && after[i].result == before[i].result, test,
+              "the buyer's matches after the buy");
+    }
+    check(world.get_last_matches(2, 8, after).status() == StatusType::FAILURE, test, "the bought team");
+
+    //A new match of the buyer is its newest one, and is recorded from both sides
+    output_t<int> result = world.play_match(1, 3);
+    check(result.status() == StatusType::SUCCESS, test, "match after the buy");
+    output_t<int> numNewer = world.get_last_matches(1, 8, after);
+    check(numNewer.status() == StatusType::SUCCESS && numNewer.ans() == numBefore.ans() + 1, test,
+          "the buyer's matches after a new match");
+    check(after[0].opponentId == 3 && after[0].result == result.ans(), test, "the buyer's newest match");
+    for (int i = 1; i < numNewer.ans(); i++) {
+        check(after[i].opponentId == before[i - 1].opponentId, test, "the buyer's older matches");
+    }
+    MatchRecord opponent[8];
+    check(world.get_last_matches(3, 1, opponent).ans() == 1 && opponent[0].opponentId == 1 &&
+          opponent[0].score == after[0].opponentScore && opponent[0].opponentScore == after[0].score, test,
+          "the opponent's newest match");
+
+    //A new team with the bought team's ID does not get its matches
+    check(world.add_team(2) == StatusType::SUCCESS, test, "add the bought team's ID");
+    output_t<int> numNew = world.get_last_matches(2, 8, after);
+    check(numNew.status() == StatusType::SUCCESS && numNew.ans() == 0, test, "the new team's matches");
+}
+
+int main()
+{
+    test_merge_from();
+    test_buy_teams();
+    test_remove_teams();
+    test_last_matches_across_buy();
+    return report_checks();
+}
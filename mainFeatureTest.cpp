@@ -0,0 +1,1116 @@
+//
+// Behavior tests of the features of world_cup_t beyond the course interface, one test per feature.
+//
+// Every test checks the answers of a feature against values that the test works out on its own (from the public
+// queries of the course interface, or by brute force), or against a second world that reaches the same state in
+// another way. The process exits with 1 if any check fails.
+//
+// Build (not part of the submission, since it has its own main):
+//   g++ -std=c++11 -Wall -o FeatureTester mainFeatureTest.cpp worldcup23a2.cpp Teams.cpp PlayerTable.cpp Spirit.cpp
+//       SpiritBatch.cpp RankFenwick.cpp RankKeyScanner.cpp FrozenSnapshot.cpp SeasonSimulator.cpp TeamSlots.cpp
+//       MatchHistory.cpp
+//
+
+#include "worldcup23a2.h"
+#include "RankKeyScanner.h"
+#include "DriverUtils.h"
+#include <iostream>
+
+using namespace std;
+
+//----------------------------------------------Helpers------------------------------------------------
+
+/*
+ * A small league whose team abilities and spirits the test knows: the teams 1, ..., MAX_TEAMS, each with one
+ *      goalkeeper of a random ability and spirit, random matches, and a few buys (the buyer gets the ability of the
+ *      bought team, and the bought team's spirit is composed after its own). In a level league the abilities are 0 or
+ *      1 and the spirits are neutral, so many of the matches are ties.
+ */
+struct KnownLeague {
+    enum {
+        MAX_TEAMS = 24
+    };
+
+    world_cup_t world;
+    int abilities[MAX_TEAMS + 1];
+    permutation_t spirits[MAX_TEAMS + 1];
+    bool exists[MAX_TEAMS + 1];
+
+    explicit KnownLeague(unsigned int seed, const bool level = false)
+    {
+        g_seed = seed;
+        for (int t = 1; t <= MAX_TEAMS; t++) {
+            abilities[t] = level ? next_random(2) : next_random(200) - 100;
+            spirits[t] = level ? permutation_t::neutral() : random_spirit();
+            exists[t] = true;
+            world.add_team(t);
+            world.add_player(t, t, spirits[t], 0, abilities[t], 0, true);
+        }
+        play_random_matches(world, 1, MAX_TEAMS, 3 * MAX_TEAMS);
+        for (int i = 0; i < 4; i++) {
+            buy(1 + next_random(MAX_TEAMS), 1 + next_random(MAX_TEAMS));
+        }
+        play_random_matches(world, 1, MAX_TEAMS, MAX_TEAMS);
+    }
+
+    void buy(const int buyerId, const int boughtId)
+    {
+        if (world.buy_team(buyerId, boughtId) == StatusType::SUCCESS) {
+            abilities[buyerId] += abilities[boughtId];
+            spirits[buyerId] = spirits[buyerId] * spirits[boughtId];
+            exists[boughtId] = false;
+        }
+    }
+
+    int score(const int teamId)
+    {
+        return world.get_team_points(teamId).ans() + abilities[teamId];
+    }
+};
+
+//----------------------------------------------Score Index------------------------------------------------
+
+static void test_score_index()
+{
+    const char* test = "score index";
+    KnownLeague league(27);
+    //The rank of a team is the number of teams before it by score, and then by ID
+    int numTeams = 0;
+    for (int t = 1; t <= KnownLeague::MAX_TEAMS; t++) {
+        if (!league.exists[t]) {
+            check(league.world.get_team_score_rank(t).status() == StatusType::FAILURE, test, "rank of a bought team");
+            continue;
+        }
+        numTeams++;
+        int rank = 0;
+        for (int u = 1; u <= KnownLeague::MAX_TEAMS; u++) {
+            if (league.exists[u] && (league.score(u) < league.score(t) ||
+                                     (league.score(u) == league.score(t) && u < t))) {
+                rank++;
+            }
+        }
+        output_t<int> found = league.world.get_team_score_rank(t);
+        check(found.status() == StatusType::SUCCESS && found.ans() == rank, test, "rank of a team");
+        output_t<int> team = league.world.get_ith_team_by_score(rank);
+        check(team.status() == StatusType::SUCCESS && team.ans() == t, test, "team of a rank");
+    }
+    check(league.world.get_ith_team_by_score(-1).status() == StatusType::FAILURE, test, "negative rank");
+    check(league.world.get_ith_team_by_score(numTeams).status() == StatusType::FAILURE, test, "rank out of range");
+    check(league.world.get_team_score_rank(0).status() == StatusType::INVALID_INPUT, test, "invalid ID");
+}
+
+//--------------------------------------------Knockout Winner---------------------------------------------
+
+/*
+ * The winner of a knockout between the given teams (in the order of their IDs), worked out round by round into a
+ *      second array: the teams play in pairs, and a team left without a pair moves on to the next round
+ */
+static int brute_force_knockout(KnownLeague& league, const int* teamIds, const int numTeams)
+{
+    int current[KnownLeague::MAX_TEAMS];
+    long long scores[KnownLeague::MAX_TEAMS];
+    for (int i = 0; i < numTeams; i++) {
+        current[i] = teamIds[i];
+        scores[i] = league.score(teamIds[i]);
+    }
+    int numLeft = numTeams;
+    while (numLeft > 1) {
+        int next[KnownLeague::MAX_TEAMS];
+        long long nextScores[KnownLeague::MAX_TEAMS];
+        int numNext = 0;
+        for (int i = 0; i < numLeft; i += 2) {
+            if (i + 1 == numLeft) {
+                next[numNext] = current[i];
+                nextScores[numNext++] = scores[i];
+                continue;
+            }
+            int first = current[i];
+            int second = current[i + 1];
+            int strength1 = league.spirits[first].strength();
+            int strength2 = league.spirits[second].strength();
+            bool firstWins = scores[i] > scores[i + 1] ||
+                             (scores[i] == scores[i + 1] && (strength1 > strength2 ||
+                                                             (strength1 == strength2 && first > second)));
+            //The winner gets the scores of both teams, and 3 more
+            next[numNext] = firstWins ? first : second;
+            nextScores[numNext++] = scores[i] + scores[i + 1] + 3;
+        }
+        for (int i = 0; i < numNext; i++) {
+            current[i] = next[i];
+            scores[i] = nextScores[i];
+        }
+        numLeft = numNext;
+    }
+    return current[0];
+}
+
+static void test_knockout_winner()
+{
+    const char* test = "knockout_winner";
+    KnownLeague league(29);
+    //Teams without a goalkeeper cannot play, so they do not take part in the knockout
+    const int noGoalkeeper = KnownLeague::MAX_TEAMS + 1;
+    const int noPlayers = KnownLeague::MAX_TEAMS + 2;
+    league.world.add_team(noGoalkeeper);
+    league.world.add_player(1000, noGoalkeeper, random_spirit(), 0, 500, 0, false);
+    league.world.add_team(noPlayers);
+    for (int minTeamId = 1; minTeamId <= noPlayers; minTeamId++) {
+        for (int maxTeamId = minTeamId; maxTeamId <= noPlayers; maxTeamId++) {
+            int teamIds[KnownLeague::MAX_TEAMS];
+            int numTeams = 0;
+            for (int t = minTeamId; t <= maxTeamId && t <= KnownLeague::MAX_TEAMS; t++) {
+                if (league.exists[t]) {
+                    teamIds[numTeams++] = t;
+                }
+            }
+            output_t<int> winner = league.world.knockout_winner(minTeamId, maxTeamId);
+            if (numTeams == 0) {
+                check(winner.status() == StatusType::FAILURE, test, "range without teams that can play");
+                continue;
+            }
+            check(winner.status() == StatusType::SUCCESS &&
+                  winner.ans() == brute_force_knockout(league, teamIds, numTeams), test, "winner of a range");
+        }
+    }
+    //The knockout does not change the points of the teams
+    for (int t = 1; t <= KnownLeague::MAX_TEAMS; t++) {
+        if (league.exists[t]) {
+            check(league.world.get_team_points(t).ans() + league.abilities[t] == league.score(t), test,
+                  "points after the knockouts");
+        }
+    }
+    check(league.world.knockout_winner(0, 5).status() == StatusType::INVALID_INPUT, test, "invalid minimum ID");
+    check(league.world.knockout_winner(1, 0).status() == StatusType::INVALID_INPUT, test, "invalid maximum ID");
+    check(league.world.knockout_winner(6, 5).status() == StatusType::INVALID_INPUT, test, "empty range");
+
+    //Equal scores: the stronger spirit wins, and with equal spirits the higher ID wins
+    world_cup_t ties;
+    int strong[permutation_t::N];
+    for (int i = 0; i < permutation_t::N; i++) {
+        strong[i] = permutation_t::N - 1 - i;
+    }
+    for (int t = 1; t <= 3; t++) {
+        ties.add_team(t);
+        ties.add_player(t, t, (t == 1) ? permutation_t(strong) : permutation_t::neutral(), 0, 10, 0, true);
+    }
+    bool strongerWins = permutation_t(strong).strength() > permutation_t::neutral().strength();
+    check(same_output(ties.knockout_winner(1, 2), output_t<int>(strongerWins ? 1 : 2)), test, "tie by spirit");
+    check(same_output(ties.knockout_winner(2, 3), output_t<int>(3)), test, "tie by ID");
+}
+
+//----------------------------------------------Freeze Mode------------------------------------------------
+
+/*
+ * A random write of the course interface, the same in both worlds
+ */
+static void random_write(world_cup_t& world, world_cup_t& expected, const int maxTeamId, int& nextPlayer,
+                         const char* test)
+{
+    int kind = next_random(6);
+    int teamId1 = 1 + next_random(maxTeamId);
+    int teamId2 = 1 + next_random(maxTeamId);
+    int playerId = 1 + next_random(nextPlayer);
+    int amount = next_random(5);
+    permutation_t spirit = random_spirit();
+    bool goalKeeper = next_random(2) == 0;
+    switch (kind) {
+    case 0:
+        check(world.add_team(teamId1) == expected.add_team(teamId1), test, "status of add_team");
+        break;
+    case 1:
+        check(world.remove_team(teamId1) == expected.remove_team(teamId1), test, "status of remove_team");
+        break;
+    case 2:
+        check(world.add_player(nextPlayer, teamId1, spirit, amount, amount - 2, 0, goalKeeper) ==
+              expected.add_player(nextPlayer, teamId1, spirit, amount, amount - 2, 0, goalKeeper), test,
+              "status of add_player");
+        nextPlayer++;
+        break;
+    case 3:
+        check(world.add_player_cards(playerId, amount) == expected.add_player_cards(playerId, amount), test,
+              "status of add_player_cards");
+        break;
+    case 4:
+        check(world.buy_team(teamId1, teamId2) == expected.buy_team(teamId1, teamId2), test, "status of buy_team");
+        break;
+    default:
+        check(same_output(world.play_match(teamId1, teamId2), expected.play_match(teamId1, teamId2)), test,
+              "result of play_match");
+        break;
+    }
+}
+
+static void test_freeze()
+{
+    const char* test = "freeze";
+    const int maxTeamId = 30;
+    world_cup_t world;
+    world_cup_t expected;
+    g_seed = 30;
+    add_league(world, 1, 20, 1, 3, 200, 4);
+    play_random_matches(world, 1, 20, 60);
+    g_seed = 30;
+    add_league(expected, 1, 20, 1, 3, 200, 4);
+    play_random_matches(expected, 1, 20, 60);
+
+    //The frozen world answers every query as the live one, and freezing it again changes nothing
+    check(world.freeze() == StatusType::SUCCESS, test, "freeze");
+    compare_worlds(world, expected, maxTeamId, 60, test);
+    check(world.freeze() == StatusType::SUCCESS, test, "freeze twice");
+    compare_worlds(world, expected, maxTeamId, 60, test);
+    check(same_output(world.get_team_points(0), expected.get_team_points(0)), test, "invalid team ID");
+    check(same_output(world.get_player_cards(0), expected.get_player_cards(0)), test, "invalid player ID");
+    check(same_output(world.get_ith_pointless_ability(-1), expected.get_ith_pointless_ability(-1)), test,
+          "negative rank");
+
+    //Every write thaws the world, so the queries after it see the write, frozen again or not
+    int nextPlayer = 61;
+    for (int i = 0; i < 300; i++) {
+        g_seed = 300 + i;
+        random_write(world, expected, maxTeamId, nextPlayer, test);
+        if (i % 3 == 0) {
+            check(world.freeze() == StatusType::SUCCESS, test, "freeze after a write");
+        }
+        compare_worlds(world, expected, maxTeamId, nextPlayer, test);
+    }
+}
+
+//---------------------------------------------Find Policies-----------------------------------------------
+
+/*
+ * A league of 64 teams that are united in pairs into 4 teams, so that the players are deep in the union-find
+ */
+static void deep_league(world_cup_t& world)
+{
+    g_seed = 31;
+    add_league(world, 1, 64, 1, 2, 200, 4);
+    play_random_matches(world, 1, 64, 64);
+    unite_in_pairs(world, 64, 4);
+}
+
+/*
+ * The number of parent links the first find of a player follows in a fresh deep league, under a policy
+ */
+static int first_find_links(const FindPolicy policy, const int playerId)
+{
+    world_cup_t world;
+    world.set_find_policy(policy);
+    deep_league(world);
+    world.reset_union_find_stats();
+    world.num_played_games_for_player(playerId);
+    const UnionFindStats& stats = world.get_union_find_stats();
+    for (int i = 0; i < UnionFindStats::NUM_BUCKETS; i++) {
+        if (stats.findSteps[i] > 0) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+static void test_find_policies()
+{
+    const char* test = "find policies";
+    const int numPlayers = 128;
+    const FindPolicy policies[] = {FindPolicy::PATH_HALVING, FindPolicy::PATH_SPLITTING};
+    for (int p = 0; p < 2; p++) {
+        //The default policy (full compression) against another one, and against a switch of policies in the middle
+        world_cup_t expected;
+        world_cup_t world;
+        world_cup_t switched;
+        deep_league(expected);
+        world.set_find_policy(policies[p]);
+        deep_league(world);
+        deep_league(switched);
+        int ids[numPlayers];
+        for (int i = 0; i < numPlayers; i++) {
+            ids[i] = i + 1;
+        }
+        g_seed = 310 + p;
+        shuffle(ids, numPlayers);
+        //The queries in a random order, with cards and matches between them, so that every find starts elsewhere
+        for (int i = 0; i < numPlayers; i++) {
+            if (i == numPlayers / 2) {
+                switched.set_find_policy(policies[p]);
+            }
+            check(same_output(world.num_played_games_for_player(ids[i]),
+                              expected.num_played_games_for_player(ids[i])) &&
+                  same_output(switched.num_played_games_for_player(ids[i]),
+                              expected.num_played_games_for_player(ids[i])), test, "player games");
+            check(same_spirit(world.get_partial_spirit(ids[i]), expected.get_partial_spirit(ids[i])) &&
+                  same_spirit(switched.get_partial_spirit(ids[i]), expected.get_partial_spirit(ids[i])), test,
+                  "partial spirit");
+            StatusType status = expected.add_player_cards(ids[i], 1);
+            check(world.add_player_cards(ids[i], 1) == status && switched.add_player_cards(ids[i], 1) == status,
+                  test, "status of add_player_cards");
+            if (i % 8 == 0) {
+                int team1 = 1 + 16 * next_random(4);
+                int team2 = 1 + 16 * next_random(4);
+                output_t<int> result = expected.play_match(team1, team2);
+                check(same_output(world.play_match(team1, team2), result) &&
+                      same_output(switched.play_match(team1, team2), result), test, "result of play_match");
+            }
+        }
+        compare_worlds(world, expected, 64, numPlayers, test);
+        compare_worlds(switched, expected, 64, numPlayers, test);
+    }
+
+    //The statistics count every parent link that a find follows, the same way for every policy
+    int maxLinks = 0;
+    for (int playerId = 1; playerId <= numPlayers; playerId += 3) {
+        int links = first_find_links(FindPolicy::FULL_COMPRESSION, playerId);
+        check(first_find_links(FindPolicy::PATH_HALVING, playerId) == links &&
+              first_find_links(FindPolicy::PATH_SPLITTING, playerId) == links, test, "parent links of a find");
+        maxLinks = (links > maxLinks) ? links : maxLinks;
+    }
+    check(maxLinks > 2, test, "deep paths");
+}
+
+//------------------------------------------Export Team Players--------------------------------------------
+
+/*
+ * Check if two permutations are equal: only the neutral permutation has the strength of the neutral permutation
+ */
+static bool same_permutation(const permutation_t& a, const permutation_t& b)
+{
+    return a.isvalid() && b.isvalid() && (a.inv() * b).strength() == permutation_t::neutral().strength();
+}
+
+static void test_export_team_players()
+{
+    const char* test = "export_team_players";
+    const int numTeams = 16;
+    const int numPlayers = 64;
+    world_cup_t world;
+    g_seed = 38;
+    add_league(world, 1, numTeams, 1, 4, 200, 4);
+    play_random_matches(world, 1, numTeams, 48);
+    unite_in_pairs(world, numTeams / 2, 2);
+    play_random_matches(world, 1, numTeams, 16);
+    world.remove_team(numTeams);
+
+    //Every player of a current team is exported once, with the values of the single player queries
+    int exported[numPlayers + 1] = {0};
+    int playerIds[numPlayers];
+    int gamesPlayed[numPlayers];
+    permutation_t partialSpirits[numPlayers];
+    for (int teamId = 1; teamId <= numTeams; teamId++) {
+        output_t<int> numExported = world.export_team_players(teamId, playerIds, gamesPlayed, partialSpirits,
+                                                              numPlayers);
+        if (world.get_team_points(teamId).status() != StatusType::SUCCESS) {
+            check(numExported.status() == StatusType::FAILURE, test, "team that doesn't exist");
+            continue;
+        }
+        check(numExported.status() == StatusType::SUCCESS, test, "export");
+        for (int i = 0; i < numExported.ans(); i++) {
+            exported[playerIds[i]]++;
+            check(world.num_played_games_for_player(playerIds[i]).ans() == gamesPlayed[i], test, "player games");
+            check(same_permutation(world.get_partial_spirit(playerIds[i]).ans(), partialSpirits[i]), test,
+                  "partial spirit");
+        }
+        if (numExported.ans() > 0) {
+            check(world.export_team_players(teamId, playerIds, gamesPlayed, partialSpirits,
+                                            numExported.ans() - 1).status() == StatusType::FAILURE, test,
+                  "buffers too small");
+        }
+    }
+    for (int playerId = 1; playerId <= numPlayers; playerId++) {
+        bool current = world.get_partial_spirit(playerId).status() == StatusType::SUCCESS;
+        check(exported[playerId] == (current ? 1 : 0), test, "players that are exported");
+    }
+    check(world.export_team_players(0, playerIds, gamesPlayed, partialSpirits, numPlayers).status() ==
+          StatusType::INVALID_INPUT, test, "invalid ID");
+    check(world.export_team_players(1, nullptr, gamesPlayed, partialSpirits, numPlayers).status() ==
+          StatusType::INVALID_INPUT, test, "missing buffer");
+}
+
+//---------------------------------------------Team Totals-------------------------------------------------
+
+static void test_team_totals()
+{
+    const char* test = "get_team_cards";
+    const int maxTeamId = 16;
+    const int maxPlayers = 200;
+    //The team of every player, followed by the test through the buys and the removals (0 for no team)
+    int owners[maxPlayers + 1] = {0};
+    world_cup_t world;
+    g_seed = 39;
+    add_league(world, 1, maxTeamId, 1, 3, 200, 4);
+    int numPlayers = 3 * maxTeamId;
+    for (int p = 1; p <= numPlayers; p++) {
+        owners[p] = 1 + (p - 1) / 3;
+    }
+    for (int i = 0; i < 300; i++) {
+        int kind = next_random(10);
+        int teamId1 = 1 + next_random(maxTeamId);
+        int teamId2 = 1 + next_random(maxTeamId);
+        if (kind < 3) {
+            int playerId = 1 + next_random(numPlayers);
+            StatusType status = world.add_player_cards(playerId, next_random(4));
+            check(status == ((owners[playerId] != 0) ? StatusType::SUCCESS : StatusType::FAILURE), test,
+                  "status of add_player_cards");
+        }
+        else if (kind < 6) {
+            world.play_match(teamId1, teamId2);
+        }
+        else if (kind < 8 && numPlayers < maxPlayers) {
+            if (world.add_player(numPlayers + 1, teamId1, random_spirit(), next_random(3), 0, next_random(3), true) ==
+                StatusType::SUCCESS) {
+                owners[++numPlayers] = teamId1;
+            }
+        }
+        else if (kind == 8 && world.buy_team(teamId1, teamId2) == StatusType::SUCCESS) {
+            for (int p = 1; p <= numPlayers; p++) {
+                owners[p] = (owners[p] == teamId2) ? teamId1 : owners[p];
+            }
+        }
+        else if (kind == 9 && next_random(3) == 0 && world.remove_team(teamId1) == StatusType::SUCCESS) {
+            for (int p = 1; p <= numPlayers; p++) {
+                owners[p] = (owners[p] == teamId1) ? 0 : owners[p];
+            }
+        }
+        //The totals of a team are the sums of the single player queries over its current players
+        for (int teamId = 1; teamId <= maxTeamId; teamId++) {
+            int cards = 0;
+            int games = 0;
+            for (int p = 1; p <= numPlayers; p++) {
+                if (owners[p] == teamId) {
+                    cards += world.get_player_cards(p).ans();
+                    games += world.num_played_games_for_player(p).ans();
+                }
+            }
+            if (world.get_team_points(teamId).status() != StatusType::SUCCESS) {
+                check(world.get_team_cards(teamId).status() == StatusType::FAILURE &&
+                      world.get_team_player_games(teamId).status() == StatusType::FAILURE, test,
+                      "team that doesn't exist");
+                continue;
+            }
+            check(same_output(world.get_team_cards(teamId), output_t<int>(cards)), test, "team cards");
+            check(same_output(world.get_team_player_games(teamId), output_t<int>(games)), test, "team player games");
+        }
+    }
+    //Only the players of a current team get cards (every time), and the totals follow them
+    for (int k = 0; k < 2; k++) {
+        for (int p = 1; p <= numPlayers; p++) {
+            check(world.add_player_cards(p, 1) == ((owners[p] != 0) ? StatusType::SUCCESS : StatusType::FAILURE),
+                  test, "status of add_player_cards");
+        }
+    }
+    for (int teamId = 1; teamId <= maxTeamId; teamId++) {
+        int cards = 0;
+        for (int p = 1; p <= numPlayers; p++) {
+            cards += (owners[p] == teamId) ? world.get_player_cards(p).ans() : 0;
+        }
+        output_t<int> teamCards = world.get_team_cards(teamId);
+        check(teamCards.status() != StatusType::SUCCESS || teamCards.ans() == cards, test, "team cards");
+    }
+    check(world.get_team_cards(0).status() == StatusType::INVALID_INPUT, test, "invalid ID");
+    check(world.get_team_player_games(-1).status() == StatusType::INVALID_INPUT, test, "invalid ID");
+}
+
+//---------------------------------------------Match Days--------------------------------------------------
+
+static void test_play_matches()
+{
+    const char* test = "play_matches";
+    const int maxTeamId = 24;
+    const int numMatches = 400;
+    world_cup_t world;
+    world_cup_t expected;
+    g_seed = 41;
+    add_league(world, 1, 20, 1, 2, 50, 1);
+    g_seed = 41;
+    add_league(expected, 1, 20, 1, 2, 50, 1);
+    //A team without a goalkeeper cannot play, and the IDs above 20 don't exist
+    world.add_team(21);
+    expected.add_team(21);
+    world.add_player(100, 21, permutation_t::neutral(), 0, 0, 0, false);
+    expected.add_player(100, 21, permutation_t::neutral(), 0, 0, 0, false);
+
+    //Match days of different sizes, with some teams in many matches (many rounds), invalid IDs and repeating pairs
+    int teamIds1[numMatches];
+    int teamIds2[numMatches];
+    int results[numMatches];
+    StatusType statuses[numMatches];
+    int firstMatch = 0;
+    for (int day = 1; firstMatch + day * day <= numMatches; day++) {
+        int dayMatches = day * day;
+        for (int i = 0; i < dayMatches; i++) {
+            bool busyTeam = next_random(3) == 0;
+            teamIds1[i] = busyTeam ? 1 + next_random(3) : next_random(maxTeamId + 1);
+            teamIds2[i] = next_random(maxTeamId + 1);
+        }
+        check(world.play_matches(teamIds1, teamIds2, dayMatches, results, statuses) == StatusType::SUCCESS, test,
+              "match day");
+        for (int i = 0; i < dayMatches; i++) {
+            output_t<int> result = expected.play_match(teamIds1[i], teamIds2[i]);
+            check(statuses[i] == result.status(), test, "status of a match");
+            check(results[i] == ((result.status() == StatusType::SUCCESS) ? result.ans() : -1), test,
+                  "result of a match");
+        }
+        compare_worlds(world, expected, maxTeamId, 41, test);
+        firstMatch += dayMatches;
+    }
+    //The head-to-head records come from the same matches, in the same order
+    for (int teamId1 = 1; teamId1 <= 4; teamId1++) {
+        for (int teamId2 = 1; teamId2 <= maxTeamId; teamId2++) {
+            HeadToHead record = {0, 0, 0};
+            HeadToHead expectedRecord = {0, 0, 0};
+            StatusType status = world.get_head_to_head(teamId1, teamId2, record);
+            check(status == expected.get_head_to_head(teamId1, teamId2, expectedRecord), test,
+                  "status of head to head");
+            check(record.wins == expectedRecord.wins && record.ties == expectedRecord.ties &&
+                  record.losses == expectedRecord.losses, test, "head to head");
+        }
+    }
+    check(world.play_matches(teamIds1, nullptr, 1, results, statuses) == StatusType::INVALID_INPUT, test,
+          "missing array");
+    check(world.play_matches(teamIds1, teamIds2, 0, results, statuses) == StatusType::SUCCESS, test, "empty day");
+}
+
+//-------------------------------------------Season Simulation---------------------------------------------
+
+/*
+ * The standings of a round-robin season of the teams of the league that exist, worked out by the circle method on
+ *      their own: in round r, the team in position p > 0 is the one that started in position 1 + (p - 1 - r) mod
+ *      (n - 1), and it plays the team in position n - 1 - p (with an odd number of teams, position 0 is a bye)
+ * @return - the number of teams
+ */
+static int brute_force_season(KnownLeague& league, int* teamIds, int* points)
+{
+    const int maxTeams = KnownLeague::MAX_TEAMS;
+    int start[maxTeams + 2];
+    int seasonPoints[maxTeams + 1];
+    int numTeams = 0;
+    for (int t = 1; t <= maxTeams; t++) {
+        if (league.exists[t]) {
+            numTeams++;
+            seasonPoints[t] = league.world.get_team_points(t).ans();
+        }
+    }
+    int numPositions = numTeams + numTeams % 2;
+    int position = numPositions - numTeams;
+    start[0] = 0;
+    for (int t = 1; t <= maxTeams; t++) {
+        if (league.exists[t]) {
+            start[position++] = t;
+        }
+    }
+    bool played[maxTeams + 1][maxTeams + 1] = {};
+    for (int round = 0; round + 1 < numPositions; round++) {
+        int current[maxTeams + 2];
+        current[0] = start[0];
+        for (int p = 1; p < numPositions; p++) {
+            int offset = ((p - 1 - round) % (numPositions - 1) + (numPositions - 1)) % (numPositions - 1);
+            current[p] = start[1 + offset];
+        }
+        for (int p = 0; p < numPositions / 2; p++) {
+            int team1 = current[p];
+            int team2 = current[numPositions - 1 - p];
+            if (team1 == 0) {
+                continue;
+            }
+            check(!played[team1][team2], "simulate_season", "brute force plays a pair twice");
+            played[team1][team2] = played[team2][team1] = true;
+            int score1 = seasonPoints[team1] + league.abilities[team1];
+            int score2 = seasonPoints[team2] + league.abilities[team2];
+            int strength1 = league.spirits[team1].strength();
+            int strength2 = league.spirits[team2].strength();
+            if (score1 > score2 || (score1 == score2 && strength1 > strength2)) {
+                seasonPoints[team1] += 3;
+            }
+            else if (score2 > score1 || strength2 > strength1) {
+                seasonPoints[team2] += 3;
+            }
+            else {
+                seasonPoints[team1] += 1;
+                seasonPoints[team2] += 1;
+            }
+        }
+    }
+    //Selection sort by the points (highest first), and then by the ID
+    numTeams = 0;
+    for (int t = 1; t <= maxTeams; t++) {
+        if (league.exists[t]) {
+            teamIds[numTeams] = t;
+            points[numTeams++] = seasonPoints[t];
+        }
+    }
+    for (int i = 0; i < numTeams; i++) {
+        int best = i;
+        for (int j = i + 1; j < numTeams; j++) {
+            if (points[j] > points[best] || (points[j] == points[best] && teamIds[j] < teamIds[best])) {
+                best = j;
+            }
+        }
+        int teamId = teamIds[i];
+        int teamPoints = points[i];
+        teamIds[i] = teamIds[best];
+        points[i] = points[best];
+        teamIds[best] = teamId;
+        points[best] = teamPoints;
+    }
+    return numTeams;
+}
+
+static void test_simulate_season()
+{
+    const char* test = "simulate_season";
+    const int maxTeams = KnownLeague::MAX_TEAMS;
+    const SeasonKernel kernels[3] = {SeasonKernel::BEST, SeasonKernel::SCALAR, SeasonKernel::SSE2};
+    //An even and an odd number of teams (the odd one has a bye in every round), and a level league with many ties
+    for (unsigned int seed = 42; seed < 45; seed++) {
+        KnownLeague league(seed, seed == 44);
+        KnownLeague twin(seed, seed == 44);
+        if (seed == 43) {
+            for (int t = 1; t <= maxTeams; t++) {
+                if (league.exists[t]) {
+                    league.buy(t, (t % maxTeams) + 1);
+                    twin.buy(t, (t % maxTeams) + 1);
+                    break;
+                }
+            }
+        }
+        //A team without a goalkeeper does not take part in the season
+        permutation_t spirit = random_spirit();
+        league.world.add_team(maxTeams + 1);
+        league.world.add_player(1000, maxTeams + 1, spirit, 0, 500, 0, false);
+        twin.world.add_team(maxTeams + 1);
+        twin.world.add_player(1000, maxTeams + 1, spirit, 0, 500, 0, false);
+
+        int expectedIds[maxTeams];
+        int expectedPoints[maxTeams];
+        int numTeams = brute_force_season(league, expectedIds, expectedPoints);
+        for (int k = 0; k < 3; k++) {
+            int teamIds[maxTeams];
+            int points[maxTeams];
+            output_t<int> result = league.world.simulate_season(teamIds, points, maxTeams, kernels[k]);
+            check(same_output(result, output_t<int>(numTeams)), test, "number of teams");
+            for (int i = 0; i < numTeams && result.status() == StatusType::SUCCESS; i++) {
+                check(teamIds[i] == expectedIds[i] && points[i] == expectedPoints[i], test, "standings");
+            }
+        }
+        //The season does not change the league
+        compare_worlds(league.world, twin.world, maxTeams + 1, 1000, test);
+        int teamIds[maxTeams];
+        int points[maxTeams];
+        check(league.world.simulate_season(teamIds, points, numTeams - 1).status() == StatusType::FAILURE, test,
+              "small arrays");
+        check(league.world.simulate_season(nullptr, points, maxTeams).status() == StatusType::INVALID_INPUT, test,
+              "missing array");
+    }
+}
+
+//-----------------------------------------------Handles---------------------------------------------------
+
+static void test_handles()
+{
+    const char* test = "handles";
+    const int numTeams = 6;
+    //Two worlds with the same teams and players, so the handles of one have valid slots and indices in the other
+    world_cup_t world;
+    world_cup_t other;
+    TeamHandle teams[numTeams + 1];
+    PlayerHandle players[numTeams + 1];
+    TeamHandle otherTeams[numTeams + 1];
+    PlayerHandle otherPlayers[numTeams + 1];
+    g_seed = 44;
+    for (int t = 1; t <= numTeams; t++) {
+        permutation_t spirit = random_spirit();
+        int ability = next_random(100);
+        check(world.add_team(t, teams[t]) == StatusType::SUCCESS, test, "add team");
+        check(other.add_team(t, otherTeams[t]) == StatusType::SUCCESS, test, "add team");
+        check(world.add_player(t, teams[t], spirit, 0, ability, 0, true, players[t]) == StatusType::SUCCESS, test,
+              "add player");
+        check(other.add_player(t, otherTeams[t], spirit, 0, ability, 0, true, otherPlayers[t]) == StatusType::SUCCESS,
+              test, "add player");
+    }
+    play_random_matches(world, 1, numTeams, 20);
+
+    //The handles give the same answers as the IDs
+    for (int t = 1; t <= numTeams; t++) {
+        output_t<TeamHandle> team = world.resolve_team(t);
+        output_t<PlayerHandle> player = world.resolve_player(t);
+        check(team.status() == StatusType::SUCCESS && player.status() == StatusType::SUCCESS, test, "resolve");
+        check(same_output(world.get_team_points(team.ans()), world.get_team_points(t)), test, "team points");
+        check(same_output(world.get_team_points(teams[t]), world.get_team_points(t)), test, "team points");
+        check(same_output(world.num_played_games_for_player(players[t]), world.num_played_games_for_player(t)), test,
+              "player games");
+        check(same_spirit(world.get_partial_spirit(player.ans()), world.get_partial_spirit(t)), test,
+              "partial spirit");
+    }
+
+    //A handle of another world is not accepted by any overload, and leaves both worlds as they were
+    for (int t = 1; t <= numTeams; t++) {
+        int next = t % numTeams + 1;
+        check(world.get_team_points(otherTeams[t]).status() == StatusType::FAILURE, test, "other world's team");
+        check(world.get_team_cards(otherTeams[t]).status() == StatusType::FAILURE, test, "other world's team");
+        check(world.play_match(teams[t], otherTeams[next]).status() == StatusType::FAILURE, test,
+              "other world's team");
+        check(world.buy_team(otherTeams[t], teams[next]) == StatusType::FAILURE, test, "other world's team");
+        check(world.remove_team(otherTeams[t]) == StatusType::FAILURE, test, "other world's team");
+        check(world.num_played_games_for_player(otherPlayers[t]).status() == StatusType::FAILURE, test,
+              "other world's player");
+        check(world.add_player_cards(otherPlayers[t], 1) == StatusType::FAILURE, test, "other world's player");
+        check(world.get_player_cards(otherPlayers[t]).status() == StatusType::FAILURE, test, "other world's player");
+        check(world.get_partial_spirit(otherPlayers[t]).status() == StatusType::FAILURE, test,
+              "other world's player");
+        check(other.get_team_points(teams[t]).status() == StatusType::FAILURE, test, "other world's team");
+        check(other.get_player_cards(players[t]).status() == StatusType::FAILURE, test, "other world's player");
+        check(same_output(world.get_team_points(teams[t]), world.get_team_points(t)), test, "team after rejects");
+        check(same_output(world.get_player_cards(players[t]), output_t<int>(0)), test, "cards after rejects");
+    }
+
+    //A removed team's handle stays invalid after its slot is given to a new team, and its players keep their handles
+    check(world.remove_team(teams[1]) == StatusType::SUCCESS, test, "remove by handle");
+    check(world.get_team_points(teams[1]).status() == StatusType::FAILURE, test, "removed team");
+    TeamHandle newTeam;
+    check(world.add_team(numTeams + 1, newTeam) == StatusType::SUCCESS, test, "add team");
+    check(world.get_team_points(teams[1]).status() == StatusType::FAILURE, test, "removed team, slot reused");
+    check(same_output(world.get_team_points(newTeam), output_t<int>(0)), test, "new team");
+    check(same_output(world.num_played_games_for_player(players[1]), world.num_played_games_for_player(1)), test,
+          "player of a removed team");
+    check(world.play_match(teams[2], teams[2]).status() == StatusType::INVALID_INPUT, test, "same team");
+}
+
+//--------------------------------------------Match History------------------------------------------------
+
+/*
+ * A match that the test recorded: the IDs of the two teams, which team with that ID each of them was (the number of
+ *      times the ID was added before it), the result of the match, and the scores of the teams before it
+ */
+struct PlayedMatch {
+    int teamIds[2];
+    int additions[2];
+    int result;
+    int scores[2];
+};
+
+/*
+ * The league of the match history test: the state of every team with an ID in [1, MAX_TEAMS], kept by the test
+ */
+struct HistoryLeague {
+    enum {
+        MAX_TEAMS = 12,
+        MAX_MATCHES = 1200
+    };
+
+    world_cup_t world;
+    bool exists[MAX_TEAMS + 1];
+    int additions[MAX_TEAMS + 1];
+    int points[MAX_TEAMS + 1];
+    int abilities[MAX_TEAMS + 1];
+    PlayedMatch matches[MAX_MATCHES];
+    int numMatches;
+
+    HistoryLeague() :
+        numMatches(0)
+    {
+        for (int t = 1; t <= MAX_TEAMS; t++) {
+            exists[t] = false;
+            additions[t] = 0;
+        }
+    }
+
+    void add(const int teamId, const int playerId)
+    {
+        exists[teamId] = true;
+        additions[teamId]++;
+        points[teamId] = 0;
+        abilities[teamId] = next_random(40);
+        world.add_team(teamId);
+        world.add_player(playerId, teamId, random_spirit(), 0, abilities[teamId], 0, true);
+    }
+
+    //Record a match that the world played, and give the points of its result
+    void record(const int teamId1, const int teamId2, const int result)
+    {
+        PlayedMatch& match = matches[numMatches++];
+        const int teamIds[2] = {teamId1, teamId2};
+        for (int side = 0; side < 2; side++) {
+            match.teamIds[side] = teamIds[side];
+            match.additions[side] = additions[teamIds[side]];
+            match.scores[side] = points[teamIds[side]] + abilities[teamIds[side]];
+        }
+        match.result = result;
+        if (result == 0) {
+            points[teamId1] += 1;
+            points[teamId2] += 1;
+        }
+        else {
+            points[(result <= 2) ? teamId1 : teamId2] += 3;
+        }
+    }
+
+    //Whether the team that has the ID now played the given side of a match
+    bool played(const PlayedMatch& match, const int side, const int teamId) const
+    {
+        return match.teamIds[side] == teamId && match.additions[side] == additions[teamId];
+    }
+};
+
+/*
+ * Check get_last_matches and get_head_to_head of every team (and pair of teams) against the recorded matches
+ */
+static void check_match_history(HistoryLeague& league, const char* test)
+{
+    const int maxTeams = HistoryLeague::MAX_TEAMS;
+    const int flipped[5] = {0, 3, 4, 1, 2};
+    for (int t = 1; t <= maxTeams; t++) {
+        MatchRecord last[HistoryLeague::MAX_MATCHES];
+        int limit = (t % 3 == 0) ? 5 : HistoryLeague::MAX_MATCHES;
+        output_t<int> numLast = league.world.get_last_matches(t, limit, last);
+        if (!league.exists[t]) {
+            check(numLast.status() == StatusType::FAILURE, test, "last matches of a team that doesn't exist");
+            continue;
+        }
+        check(same_output(league.world.get_team_points(t), output_t<int>(league.points[t])), test, "team points");
+        //The team's matches from the newest to the oldest
+        int count = 0;
+        for (int m = league.numMatches - 1; m >= 0 && count < limit; m--) {
+            const PlayedMatch& match = league.matches[m];
+            for (int side = 0; side < 2; side++) {
+                if (!league.played(match, side, t)) {
+                    continue;
+                }
+                if (count < numLast.ans()) {
+                    const MatchRecord& record = last[count];
+                    check(record.opponentId == match.teamIds[1 - side] &&
+                          record.result == ((side == 0) ? match.result : flipped[match.result]) &&
+                          record.score == match.scores[side] && record.opponentScore == match.scores[1 - side], test,
+                          "last match");
+                }
+                count++;
+            }
+        }
+        check(same_output(numLast, output_t<int>(count)), test, "number of last matches");
+
+        for (int u = 1; u <= maxTeams; u++) {
+            HeadToHead record = {-1, -1, -1};
+            StatusType status = league.world.get_head_to_head(t, u, record);
+            if (u == t || !league.exists[u]) {
+                check(status == ((u == t) ? StatusType::INVALID_INPUT : StatusType::FAILURE), test,
+                      "status of head to head");
+                continue;
+            }
+            HeadToHead expected = {0, 0, 0};
+            for (int m = 0; m < league.numMatches; m++) {
+                const PlayedMatch& match = league.matches[m];
+                for (int side = 0; side < 2; side++) {
+                    if (league.played(match, side, t) && league.played(match, 1 - side, u)) {
+                        int result = (side == 0) ? match.result : flipped[match.result];
+                        if (result == 0) {
+                            expected.ties++;
+                        }
+                        else if (result <= 2) {
+                            expected.wins++;
+                        }
+                        else {
+                            expected.losses++;
+                        }
+                    }
+                }
+            }
+            check(status == StatusType::SUCCESS && record.wins == expected.wins && record.ties == expected.ties &&
+                  record.losses == expected.losses, test, "head to head");
+        }
+    }
+}
+
+static void test_match_history()
+{
+    const char* test = "match_history";
+    const int maxTeams = HistoryLeague::MAX_TEAMS;
+    const int dayMatches = 8;
+    HistoryLeague league;
+    g_seed = 48;
+    int nextPlayer = 1;
+    for (int t = 1; t <= maxTeams - 2; t++) {
+        league.add(t, nextPlayer++);
+    }
+    //Single matches and match days, with buys, removals and teams added again under the IDs of teams that are gone
+    //  (a new team with an old ID gets none of the old team's matches)
+    for (int step = 0; step < 800 && league.numMatches + dayMatches <= HistoryLeague::MAX_MATCHES; step++) {
+        int kind = next_random(20);
+        int teamId1 = 1 + next_random(maxTeams);
+        int teamId2 = 1 + next_random(maxTeams);
+        if (kind == 0 && league.exists[teamId1] && league.exists[teamId2] && teamId1 != teamId2) {
+            check(league.world.buy_team(teamId1, teamId2) == StatusType::SUCCESS, test, "buy");
+            league.points[teamId1] += league.points[teamId2];
+            league.abilities[teamId1] += league.abilities[teamId2];
+            league.exists[teamId2] = false;
+        }
+        else if (kind == 1 && league.exists[teamId1]) {
+            check(league.world.remove_team(teamId1) == StatusType::SUCCESS, test, "remove");
+            league.exists[teamId1] = false;
+        }
+        else if (kind <= 3 && !league.exists[teamId1]) {
+            league.add(teamId1, nextPlayer++);
+        }
+        else if (kind == 4) {
+            int teamIds1[dayMatches];
+            int teamIds2[dayMatches];
+            int results[dayMatches];
+            StatusType statuses[dayMatches];
+            for (int i = 0; i < dayMatches; i++) {
+                teamIds1[i] = 1 + next_random(maxTeams);
+                teamIds2[i] = 1 + next_random(maxTeams);
+            }
+            check(league.world.play_matches(teamIds1, teamIds2, dayMatches, results, statuses) == StatusType::SUCCESS,
+                  test, "match day");
+            for (int i = 0; i < dayMatches; i++) {
+                if (statuses[i] == StatusType::SUCCESS) {
+                    league.record(teamIds1[i], teamIds2[i], results[i]);
+                }
+            }
+        }
+        else {
+            output_t<int> result = league.world.play_match(teamId1, teamId2);
+            if (result.status() == StatusType::SUCCESS) {
+                league.record(teamId1, teamId2, result.ans());
+            }
+        }
+        if (step % 50 == 49) {
+            check_match_history(league, test);
+        }
+    }
+    check(league.numMatches > 200, test, "enough matches");
+    check_match_history(league, test);
+    MatchRecord last[1];
+    check(league.world.get_last_matches(0, 1, last).status() == StatusType::INVALID_INPUT, test, "invalid ID");
+    check(league.world.get_last_matches(1, -1, last).status() == StatusType::INVALID_INPUT, test, "invalid number");
+    check(league.world.get_last_matches(1, 1, nullptr).status() == StatusType::INVALID_INPUT, test, "missing array");
+    HeadToHead record;
+    check(league.world.get_head_to_head(0, 1, record) == StatusType::INVALID_INPUT, test, "invalid ID");
+}
+
+//---------------------------------------------Offline Ranks-----------------------------------------------
+
+/*
+ * A command of a log that changes the abilities of the teams
+ */
+struct Command {
+    enum Kind {
+        ADD_TEAM,
+        REMOVE_TEAM,
+        ADD_PLAYER,
+        BUY_TEAM,
+        PLAY_MATCH
+    };
+
+    Kind kind;
+    int id1;
+    int id2;
+    int ability;
+    permutation_t spirit;
+};
+
+static StatusType replay(world_cup_t& world, const Command& command)
+{
+    switch (command.kind) {
+    case Command::ADD_TEAM:
+        return world.add_team(command.id1);
+    case Command::REMOVE_TEAM:
+        return world.remove_team(command.id1);
+    case Command::ADD_PLAYER:
+        return world.add_player(command.id1, command.id2, command.spirit, 0, command.ability, 0, true);
+    case Command::BUY_TEAM:
+        return world.buy_team(command.id1, command.id2);
+    default:
+        return world.play_match(command.id1, command.id2).status();
+    }
+}
+
+static void scan(RankKeyScanner& scanner, const Command& command)
+{
+    switch (command.kind) {
+    case Command::ADD_TEAM:
+        scanner.add_team(command.id1);
+        break;
+    case Command::REMOVE_TEAM:
+        scanner.remove_team(command.id1);
+        break;
+    case Command::ADD_PLAYER:
+        scanner.add_player(command.id1, command.id2, command.spirit, 0, command.ability, 0);
+        break;
+    case Command::BUY_TEAM:
+        scanner.buy_team(command.id1, command.id2);
+        break;
+    default:
+        break;
+    }
+}
+
+static void test_offline_ranks()
+{
+    const char* test = "offline ranks";
+    const int numCommands = 3000;
+    const int maxTeamId = 40;
+    Command* log = new Command[numCommands];
+    g_seed = 26;
+    int nextPlayer = 1;
+    for (int i = 0; i < numCommands; i++) {
+        int kind = next_random(10);
+        log[i].kind = (kind < 2) ? Command::ADD_TEAM : (kind < 3) ? Command::REMOVE_TEAM :
+                      (kind < 6) ? Command::ADD_PLAYER : (kind < 7) ? Command::BUY_TEAM : Command::PLAY_MATCH;
+        log[i].id1 = 1 + next_random(maxTeamId);
+        log[i].id2 = 1 + next_random(maxTeamId);
+        log[i].ability = next_random(200) - 100;
+        log[i].spirit = random_spirit();
+        if (log[i].kind == Command::ADD_PLAYER) {
+            log[i].id2 = log[i].id1;
+            log[i].id1 = nextPlayer++;
+        }
+    }
+    //The whole log is scanned before it is replayed
+    RankKeyScanner scanner;
+    for (int i = 0; i < numCommands; i++) {
+        scan(scanner, log[i]);
+    }
+    world_cup_t online;
+    world_cup_t offline;
+    check(offline.enable_offline_ranks(scanner.get_abilities(), scanner.get_team_ids(), scanner.get_num_keys()) ==
+          StatusType::SUCCESS, test, "enable");
+    check(offline.enable_offline_ranks(scanner.get_abilities(), scanner.get_team_ids(), scanner.get_num_keys()) ==
+          StatusType::FAILURE, test, "enable twice");
+    int numTeams = 0;
+    for (int i = 0; i < numCommands; i++) {
+        StatusType status = replay(online, log[i]);
+        check(replay(offline, log[i]) == status, test, "status of a command");
+        if (status == StatusType::SUCCESS && log[i].kind == Command::ADD_TEAM) {
+            numTeams++;
+        }
+        else if (status == StatusType::SUCCESS && (log[i].kind == Command::REMOVE_TEAM ||
+                                                   log[i].kind == Command::BUY_TEAM)) {
+            numTeams--;
+        }
+        //Every rank, after every command
+        for (int r = -1; r <= numTeams; r++) {
+            check(same_output(online.get_ith_pointless_ability(r), offline.get_ith_pointless_ability(r)), test,
+                  "ith pointless ability");
+        }
+    }
+    compare_worlds(offline, online, maxTeamId, nextPlayer, test);
+
+    //The mode can only be enabled before the first team is added
+    world_cup_t late;
+    late.add_team(1);
+    check(late.enable_offline_ranks(scanner.get_abilities(), scanner.get_team_ids(), scanner.get_num_keys()) ==
+          StatusType::FAILURE, test, "enable after a team was added");
+    delete[] log;
+}
+
+int main()
+{
+    test_score_index();
+    test_knockout_winner();
+    test_freeze();
+    test_find_policies();
+    test_export_team_players();
+    test_team_totals();
+    test_play_matches();
+    test_simulate_season();
+    test_handles();
+    test_match_history();
+    test_offline_ranks();
+    return report_checks();
+}
@@ -0,0 +1,249 @@
+//
+// Offline replay of a full command log (same input and output format as main23a2.cpp).
+//
+// The whole log is read before it is executed, so that every (ability, team ID) key that the teams will
+// reach is known in advance. The keys are collected by RankKeyScanner, and the log is then replayed on a
+// world_cup_t that answers get_ith_pointless_ability with a Fenwick tree instead of the rank tree.
+//
+// Build (not part of the submission, since it has its own main):
+//   g++ -std=c++11 -DNDEBUG -Wall -o OfflineTester mainOffline.cpp worldcup23a2.cpp Teams.cpp
+//       PlayerTable.cpp Spirit.cpp RankFenwick.cpp RankKeyScanner.cpp FrozenSnapshot.cpp SeasonSimulator.cpp
+//       TeamSlots.cpp MatchHistory.cpp
+//
+
+#include "worldcup23a2.h"
+#include "RankKeyScanner.h"
+#include <string>
+#include <iostream>
+
+using namespace std;
+
+/*
+ * The commands of the log, in the order they are checked by main23a2.cpp
+ */
+enum CommandType {
+    ADD_TEAM,
+    REMOVE_TEAM,
+    ADD_PLAYER,
+    PLAY_MATCH,
+    NUM_PLAYED_GAMES_FOR_PLAYER,
+    ADD_PLAYER_CARDS,
+    GET_PLAYER_CARDS,
+    GET_TEAM_POINTS,
+    GET_ITH_POINTLESS_ABILITY,
+    GET_PARTIAL_SPIRIT,
+    BUY_TEAM
+};
+
+static const char *CommandStr[] =
+{
+    "add_team",
+    "remove_team",
+    "add_player",
+    "play_match",
+    "num_played_games_for_player",
+    "add_player_cards",
+    "get_player_cards",
+    "get_team_points",
+    "get_ith_pointless_ability",
+    "get_partial_spirit",
+    "buy_team"
+};
+
+/*
+ * A single command of the log with all of its parameters
+ */
+struct Command {
+    CommandType type;
+    int id1;
+    int id2;
+    int d1;
+    int d2;
+    int d3;
+    bool b1;
+    permutation_t p1;
+};
+
+istream& operator>>(istream &in, permutation_t &obj)
+{
+    string str;
+    in >> str;
+    obj = permutation_t::read(str.c_str());
+    return in;
+}
+
+void print(CommandType cmd, StatusType res);
+
+template<typename T>
+void print(CommandType cmd, output_t<T> res);
+
+int main()
+{
+    cin >> std::boolalpha;
+
+    // Read the full log
+    int numCommands = 0;
+    int capacity = 1024;
+    Command* commands = new Command[capacity];
+    string op;
+    while (cin >> op)
+    {
+        if (numCommands == capacity)
+        {
+            Command* tmp = new Command[capacity * 2];
+            for (int i = 0; i < numCommands; ++i)
+            {
+                tmp[i] = commands[i];
+            }
+            delete[] commands;
+            commands = tmp;
+            capacity *= 2;
+        }
+        Command& c = commands[numCommands];
+        int type = 0;
+        while (type <= BUY_TEAM && op.compare(CommandStr[type]))
+        {
+            ++type;
+        }
+        c.type = (CommandType) type;
+        switch (c.type)
+        {
+            case ADD_TEAM:
+            case REMOVE_TEAM:
+            case GET_TEAM_POINTS:
+                cin >> c.id1;
+                break;
+            case ADD_PLAYER:
+                cin >> c.id1 >> c.id2 >> c.p1 >> c.d1 >> c.d2 >> c.d3 >> c.b1;
+                break;
+            case PLAY_MATCH:
+            case BUY_TEAM:
+                cin >> c.id1 >> c.id2;
+                break;
+            case NUM_PLAYED_GAMES_FOR_PLAYER:
+            case GET_PLAYER_CARDS:
+            case GET_PARTIAL_SPIRIT:
+                cin >> c.id1;
+                break;
+            case ADD_PLAYER_CARDS:
+                cin >> c.id1 >> c.d1;
+                break;
+            case GET_ITH_POINTLESS_ABILITY:
+                cin >> c.d1;
+                break;
+            default:
+                cout << "Unknown command: " << op << endl;
+                delete[] commands;
+                return -1;
+        }
+        if (cin.fail())
+        {
+            cout << "Invalid input format" << endl;
+            delete[] commands;
+            return -1;
+        }
+        ++numCommands;
+    }
+
+    // Pre-scan: collect every rank key the teams will reach
+    RankKeyScanner* scanner = new RankKeyScanner();
+    for (int i = 0; i < numCommands; ++i)
+    {
+        const Command& c = commands[i];
+        switch (c.type)
+        {
+            case ADD_TEAM:
+                scanner->add_team(c.id1);
+                break;
+            case REMOVE_TEAM:
+                scanner->remove_team(c.id1);
+                break;
+            case ADD_PLAYER:
+                scanner->add_player(c.id1, c.id2, c.p1, c.d1, c.d2, c.d3);
+                break;
+            case BUY_TEAM:
+                scanner->buy_team(c.id1, c.id2);
+                break;
+            default:
+                break;
+        }
+    }
+    world_cup_t *obj = new world_cup_t();
+    obj->enable_offline_ranks(scanner->get_abilities(), scanner->get_team_ids(), scanner->get_num_keys());
+    delete scanner;
+
+    // Execute all commands
+    for (int i = 0; i < numCommands; ++i)
+    {
+        const Command& c = commands[i];
+        switch (c.type)
+        {
+            case ADD_TEAM:
+                print(c.type, obj->add_team(c.id1));
+                break;
+            case REMOVE_TEAM:
+                print(c.type, obj->remove_team(c.id1));
+                break;
+            case ADD_PLAYER:
+                print(c.type, obj->add_player(c.id1, c.id2, c.p1, c.d1, c.d2, c.d3, c.b1));
+                break;
+            case PLAY_MATCH:
+                print(c.type, obj->play_match(c.id1, c.id2));
+                break;
+            case NUM_PLAYED_GAMES_FOR_PLAYER:
+                print(c.type, obj->num_played_games_for_player(c.id1));
+                break;
+            case ADD_PLAYER_CARDS:
+                print(c.type, obj->add_player_cards(c.id1, c.d1));
+                break;
+            case GET_PLAYER_CARDS:
+                print(c.type, obj->get_player_cards(c.id1));
+                break;
+            case GET_TEAM_POINTS:
+                print(c.type, obj->get_team_points(c.id1));
+                break;
+            case GET_ITH_POINTLESS_ABILITY:
+                print(c.type, obj->get_ith_pointless_ability(c.d1));
+                break;
+            case GET_PARTIAL_SPIRIT:
+                print(c.type, obj->get_partial_spirit(c.id1));
+                break;
+            case BUY_TEAM:
+                print(c.type, obj->buy_team(c.id1, c.id2));
+                break;
+        }
+    }
+    cout.flush();
+
+    // Quit
+    delete obj;
+    delete[] commands;
+    return 0;
+}
+
+// Helpers
+static const char *StatusTypeStr[] =
+{
+    "SUCCESS",
+    "ALLOCATION_ERROR",
+    "INVALID_INPUT",
+    "FAILURE"
+};
+
+void print(CommandType cmd, StatusType res)
+{
+    cout << CommandStr[cmd] << ": " << StatusTypeStr[(int) res] << '\n';
+}
+
+template<typename T>
+void print(CommandType cmd, output_t<T> res)
+{
+    if (res.status() == StatusType::SUCCESS)
+    {
+        cout << CommandStr[cmd] << ": " << StatusTypeStr[(int) res.status()] << ", " << res.ans() << '\n';
+    }
+    else
+    {
+        cout << CommandStr[cmd] << ": " << StatusTypeStr[(int) res.status()] << '\n';
+    }
+}
@@ -1,87 +1,49 @@
 #include "worldcup23a2.h"
 
+#if defined(_OPENMP)
+#define WORLDCUP_PARALLEL_ROUNDS
+#endif
+
 world_cup_t::world_cup_t() :
     m_numTotalPlayers(0),
     m_numTeams(0),
-    m_currentHashSize(7),
+    m_playerIndices(),
+    m_playerTable(),
+    m_teamIndices(),
+    m_matchHistory(),
     m_teamsByID(),
-    m_teamsByAbility()
-{
-    m_playersHashTable = new Tree<GenericNode<Player*>, Player*>*[m_currentHashSize];
-    for (int i = 0; i < m_currentHashSize; i++) {
-        m_playersHashTable[i] = new Tree<GenericNode<Player*>, Player*>();
-    }
-}
+    m_teamsByAbility(),
+    m_teamsByScore(),
+    m_offlineRanks(nullptr),
+    m_frozen(nullptr),
+    m_findPolicy(FindPolicy::FULL_COMPRESSION)
+{}
 
 world_cup_t::~world_cup_t()
 {
-    for (int i = 0; i < m_currentHashSize; i++) {
-        if (m_playersHashTable[i]->m_node->get_height() >= 0) {
-            m_playersHashTable[i]->erase_data(m_playersHashTable[i]->m_node);
-        }
-        delete m_playersHashTable[i];
-    }
-    if (m_teamsByID.m_node->get_height() >= 0) {
-        m_teamsByID.erase_data(m_teamsByID.m_node);
-    }
-    delete[] m_playersHashTable;
+    //The teams are destroyed with their slots
+    delete m_offlineRanks;
+    delete m_frozen;
 }
 
 
 StatusType world_cup_t::add_team(int teamId)
 {
-	if (teamId <= 0) {
-        return StatusType::INVALID_INPUT;
-    }
-    Team* newTeam;
-    try  {
-        newTeam = new Team(teamId);
-        m_teamsByID.insert(newTeam, teamId);
-    }
-    catch (const std::bad_alloc& e) {
-        delete newTeam;
-        return StatusType::ALLOCATION_ERROR;
-    }
-    catch(const InvalidID& e) {
-        delete newTeam;
-        return StatusType::FAILURE;
-    }
-    //Insert the team into the rank tree:
-    try {
-        m_teamsByAbility.insert(newTeam, teamId, 0);
-    }
-    catch(const std::bad_alloc& e) {
-        delete newTeam;
-        return StatusType::ALLOCATION_ERROR;
-    }
-    catch(const InvalidID& e) {
-        delete newTeam;
-        return StatusType::FAILURE;
-    }
-    m_numTeams++;
-	return StatusType::SUCCESS;
+    TeamHandle handle;
+    return add_team(teamId, handle);
 }
 
 StatusType world_cup_t::remove_team(int teamId)
 {
+    thaw();
     if (teamId <= 0) {
         return StatusType::INVALID_INPUT;
     }
-    Team* team;
-    try {
-        team = m_teamsByID.search_and_return_data(teamId);
-        m_teamsByID.remove(teamId);
-        m_teamsByAbility.remove(teamId, team->get_ability());
-        if (team->get_allPlayers() != nullptr) {
-            team->get_allPlayers()->update_gamesPlayed(team->get_games());
-            team->get_allPlayers()->detach();
-        }
-        delete team;
-    }
-    catch(const NodeNotFound& e) {
+    Team** team = m_teamIndices.find(teamId);
+    if (team == nullptr) {
         return StatusType::FAILURE;
     }
-    m_numTeams--;
+    erase_team(*team);
 	return StatusType::SUCCESS;
 }
 
@@ -89,6 +51,7 @@ StatusType world_cup_t::add_player(int playerId, int teamId,
                                    const permutation_t &spirit, int gamesPlayed,
                                    int ability, int cards, bool goalKeeper)
 {
+    thaw();
     if (playerId <= 0 || teamId <= 0 || gamesPlayed < 0 || cards < 0 || !spirit.isvalid()) {
         return StatusType::INVALID_INPUT;
     }
@@ -98,136 +61,36 @@ StatusType world_cup_t::add_player(int playerId, int teamId,
     }
     Team* tmpTeam;
     try {
-        tmpTeam = m_teamsByID.search_and_return_data(teamId);
+        tmpTeam = m_teamIndices.search_and_return_data(teamId);
     }
     catch (const NodeNotFound& e) {
         return StatusType::FAILURE;
     }
-    //The inputs are okay - continue adding player
-    Player* playerRoot = tmpTeam->get_allPlayers();
-    //Correlate the player's games played with the total team games and the root player games played
-    int playerNumGames = gamesPlayed - tmpTeam->get_games();
-    //If this player isn't the first player on the team
-    if (playerRoot != nullptr) {
-        playerNumGames -= playerRoot->get_gamesPlayed();
-    }
-    //Add the player's partial spirit-its team's spirit only including the players that joined before the current player
-    permutation_t partialSpirit = tmpTeam->get_teamSpirit();
-    //If this player isn't the first player on the team
-    if (playerRoot != nullptr) {
-        //Add the current player's spirit to its partial spirit
-        partialSpirit = partialSpirit * spirit;
-        //Inverse the root's spirit and add it to the player's partial spirit (it will be added back in the future)
-        partialSpirit = playerRoot->get_partialSpirit().inv() * partialSpirit;
-    }
-    else {
-        partialSpirit = spirit;
-    }
-    Player* tmpPlayer;
-    try {
-        tmpPlayer = new Player(playerId, playerNumGames, ability, cards, goalKeeper, spirit, partialSpirit, playerRoot);
-    }
-    catch (const std::bad_alloc& e) {
-        return StatusType::ALLOCATION_ERROR;
-    }
-    //Update the hash table if needed:
-    if (m_numTotalPlayers + 1 == m_currentHashSize) {
-        try {
-            enlarge_hash_table();
-        }
-        catch (const std::bad_alloc& e) {
-            delete tmpPlayer;
-            return StatusType::ALLOCATION_ERROR;
-        }
-    }
-    try {
-        insert_player_hash_table(tmpPlayer);
-    }
-    catch (const std::bad_alloc& e) {
-        delete tmpPlayer;
-        return StatusType::ALLOCATION_ERROR;
-    }
-    catch (const InvalidID& e) {
-        delete tmpPlayer;
-        return StatusType::FAILURE;
-    }
-    //If this is the first player in the team, update team pointer to it's players
-    if (playerRoot == nullptr) {
-        tmpPlayer->update_team(tmpTeam);
-        tmpTeam->update_players(tmpPlayer);
-    }
-    //Remove the team from the tree sorted by player ability, and update the team's stats
-    m_teamsByAbility.remove(tmpTeam->get_teamID(), tmpTeam->get_ability());
-    tmpTeam->add_player(tmpPlayer, playerId, spirit, ability, cards, goalKeeper);
-    //Re-insert the team from the tree sorted by player ability
-    try {
-        m_teamsByAbility.insert(tmpTeam, tmpTeam->get_teamID(), tmpTeam->get_ability());
-    }
-    catch (const InvalidID& e) {}
-    catch (const std::bad_alloc& e) {
-        return StatusType::ALLOCATION_ERROR;
-    }
-    m_numTotalPlayers++;
-    return StatusType::SUCCESS;
+    PlayerHandle handle;
+    return insert_player(playerId, tmpTeam, spirit, gamesPlayed, ability, cards, goalKeeper, handle);
 }
 
 output_t<int> world_cup_t::play_match(int teamId1, int teamId2)
 {
-    int result = -1;
+    thaw();
     if (teamId1 <= 0 || teamId2 <= 0 || teamId1 == teamId2) {
         return output_t<int>(StatusType::INVALID_INPUT);
     }
     Team* team1;
     Team* team2;
     try {
-        team1 = m_teamsByID.search_and_return_data(teamId1);
+        team1 = m_teamIndices.search_and_return_data(teamId1);
     }
     catch (const NodeNotFound&) {
         return output_t<int>(StatusType::FAILURE);
     }
     try {
-        team2 = m_teamsByID.search_and_return_data(teamId2);
+        team2 = m_teamIndices.search_and_return_data(teamId2);
     }
     catch (const NodeNotFound&) {
         return output_t<int>(StatusType::FAILURE);
     }
-    if (!team1->is_valid() || !team2->is_valid()) {
-        return output_t<int>(StatusType::FAILURE);
-    }
-    //Find the score for each team, and check for a winner:
-    int score1 = team1->get_score();
-    int score2 = team2->get_score();
-    if (score1 > score2) {
-        team1->update_points_won();
-        result = 1;
-    }
-    else if (score2 > score1) {
-        team2->update_points_won();
-        result = 3;
-    }
-    else {
-        //The teams were tied, so break the tie according to their spirit strength:
-        int spirit1 = team1->get_spirit_strength();
-        int spirit2 = team2->get_spirit_strength();
-        if (spirit1 > spirit2) {
-            team1->update_points_won();
-            result = 2;
-        }
-        else if (spirit2 > spirit1) {
-            team2->update_points_won();
-            result = 4;
-        }
-        else {
-            //The teams were still tied:
-            team1->update_points_tie();
-            team2->update_points_tie();
-            result = 0;
-        }
-    }
-    //Add a game to each of the teams that played:
-    team1->add_game();
-    team2->add_game();
-	return output_t<int>(result);
+	return match_teams(team1, team2);
 }
 
 output_t<int> world_cup_t::num_played_games_for_player(int playerId)
@@ -235,48 +98,24 @@ output_t<int> world_cup_t::num_played_games_for_player(int playerId)
 	if (playerId <= 0) {
         return output_t<int>(StatusType::INVALID_INPUT);
     }
-    int arrayIndex = hash_function(playerId);
-    Player* tmpPlayer;
-    try {
-        tmpPlayer = m_playersHashTable[arrayIndex]->search_and_return_data(playerId);
-    }
-    catch (const NodeNotFound& e) {
+    int* playerIndex = m_playerIndices.find(playerId);
+    if (playerIndex == nullptr) {
         return output_t<int>(StatusType::FAILURE);
     }
-    //Union-find algorithm - compress path from player to root
-    tmpPlayer->find();
-    int gamesPlayed = tmpPlayer->get_gamesPlayed();
-    //If player isn't the root of the team's players
-    if (tmpPlayer->get_parent() != nullptr) {
-        gamesPlayed += tmpPlayer->get_parent()->get_gamesPlayed();
-        if (tmpPlayer->get_parent()->get_team() != nullptr) {
-            gamesPlayed += tmpPlayer->get_parent()->get_team()->get_games();
-        }
-    }
-    else if (tmpPlayer->get_team() != nullptr) {
-        gamesPlayed += tmpPlayer->get_team()->get_games();
-    }
-    return output_t<int>(gamesPlayed);
+    return output_t<int>(player_games(*playerIndex));
 }
 
 StatusType world_cup_t::add_player_cards(int playerId, int cards)
 {
+    thaw();
     if (playerId <= 0 || cards < 0) {
         return StatusType::INVALID_INPUT;
     }
-    if (check_player_kicked_out(playerId)) {
-        return StatusType::FAILURE;
-    }
-    int arrayIndex = hash_function(playerId);
-    Player* tmpPlayer;
-    try {
-        tmpPlayer = m_playersHashTable[arrayIndex]->search_and_return_data(playerId);
-    }
-    catch (const NodeNotFound& e) {
+    int* playerIndex = m_playerIndices.find(playerId);
+    if (playerIndex == nullptr) {
         return StatusType::FAILURE;
     }
-    tmpPlayer->update_cards(cards);
-    return StatusType::SUCCESS;
+    return give_player_cards(*playerIndex, cards);
 }
 
 output_t<int> world_cup_t::get_player_cards(int playerId)
@@ -284,25 +123,37 @@ output_t<int> world_cup_t::get_player_cards(int playerId)
     if (playerId <= 0) {
         return output_t<int>(StatusType::INVALID_INPUT);
     }
-    int arrayIndex = hash_function(playerId);
-    Player* tmpPlayer;
-    try {
-        tmpPlayer = m_playersHashTable[arrayIndex]->search_and_return_data(playerId);
+    if (m_frozen != nullptr) {
+        try {
+            return output_t<int>(m_frozen->get_player_cards(playerId));
+        }
+        catch (const NodeNotFound& e) {
+            return output_t<int>(StatusType::FAILURE);
+        }
     }
-    catch (const NodeNotFound& e) {
+    int* playerIndex = m_playerIndices.find(playerId);
+    if (playerIndex == nullptr) {
         return output_t<int>(StatusType::FAILURE);
     }
-    return output_t<int>(tmpPlayer->get_cards());
+    return output_t<int>(m_playerTable.get_cards(*playerIndex));
 }
 
 output_t<int> world_cup_t::get_team_points(int teamId)
 {
     if (teamId <= 0) {
         return StatusType::INVALID_INPUT;
+    }
+    if (m_frozen != nullptr) {
+        try {
+            return output_t<int>(m_frozen->get_team_points(teamId));
+        }
+        catch (const NodeNotFound& e) {
+            return output_t<int>(StatusType::FAILURE);
+        }
     }
 	Team* t;
     try {
-        t = m_teamsByID.search_and_return_data(teamId);
+        t = m_teamIndices.search_and_return_data(teamId);
     }
     catch (const NodeNotFound& e) {
         return output_t<int>(StatusType::FAILURE);
@@ -315,6 +166,12 @@ output_t<int> world_cup_t::get_ith_pointless_ability(int i)
     if (i < 0 || m_numTeams == 0 || i >= m_numTeams) {
         return output_t<int>(StatusType::FAILURE);
     }
+    if (m_frozen != nullptr) {
+        return output_t<int>(m_frozen->get_ith_team(i));
+    }
+    if (m_offlineRanks != nullptr) {
+        return output_t<int>(m_offlineRanks->find_index(i));
+    }
     Team* team = m_teamsByAbility.find_index(m_teamsByAbility.m_node, i)->get_data();
 	return output_t<int>(team->get_teamID());
 }
@@ -324,171 +181,1564 @@ output_t<permutation_t> world_cup_t::get_partial_spirit(int playerId)
     if (playerId <= 0) {
         return output_t<permutation_t>(StatusType::INVALID_INPUT);
     }
-    if (check_player_kicked_out(playerId)) {
-        return output_t<permutation_t>(StatusType::FAILURE);
-    }
-    int arrayIndex = hash_function(playerId);
-    Player* tmpPlayer;
-    try {
-        tmpPlayer = m_playersHashTable[arrayIndex]->search_and_return_data(playerId);
-    }
-    catch (const NodeNotFound& e) {
+    int* playerIndex = m_playerIndices.find(playerId);
+    if (playerIndex == nullptr) {
         return output_t<permutation_t>(StatusType::FAILURE);
     }
-    //Union-find algorithm - compress path from player to root
-    tmpPlayer->find();
-    permutation_t playerSpirit = tmpPlayer->get_partialSpirit();
-    if (tmpPlayer->get_parent() != nullptr) {
-        playerSpirit = tmpPlayer->get_parent()->get_partialSpirit() * playerSpirit;
-    }
-    return output_t<permutation_t>(playerSpirit);
+    return player_partial_spirit(*playerIndex);
 }
 
 StatusType world_cup_t::buy_team(int teamId1, int teamId2)
 {
+    thaw();
     if (teamId1 <= 0 || teamId2 <= 0 || teamId1 == teamId2) {
         return StatusType::INVALID_INPUT;
     }
     Team* buyer;
     Team* bought;
     try {
-        buyer = m_teamsByID.search_and_return_data(teamId1);
+        buyer = m_teamIndices.search_and_return_data(teamId1);
     }
     catch (const NodeNotFound&) {
         return StatusType::FAILURE;
     }  
     try {
-        bought = m_teamsByID.search_and_return_data(teamId2);
+        bought = m_teamIndices.search_and_return_data(teamId2);
     }
     catch (const NodeNotFound&) {
         return StatusType::FAILURE;
     }
-    int prevAbility = buyer->get_ability();
-    //If both teams contain players, send to a helper function inside Player class:
-    if (buyer->get_allPlayers() != nullptr && bought->get_allPlayers() != nullptr) {
-        buyer->get_allPlayers()->update_gamesPlayed(buyer->get_games());
-        bought->get_allPlayers()->update_gamesPlayed(bought->get_games());
-        Player* root = buyer->get_allPlayers()->players_union(bought->get_allPlayers(), buyer->get_num_players(), 
-                                        bought->get_num_players(), buyer->get_teamSpirit(), bought->get_teamSpirit());
-        //Update the pointers to the team and players according to the output of the helper function above:
-        root->update_team(buyer);
-        buyer->update_players(root);
+	return unite_teams(buyer, bought);
+}
+
+
+//-------------------------------------------Handles----------------------------------------------
+
+StatusType world_cup_t::add_team(int teamId, TeamHandle& handle)
+{
+    thaw();
+	if (teamId <= 0) {
+        return StatusType::INVALID_INPUT;
     }
-    //If only the bought team contains players, update the pointers so that they belong to the buying team:
-    else if (buyer->get_allPlayers() == nullptr && bought->get_allPlayers() != nullptr) {
-        bought->get_allPlayers()->update_gamesPlayed(bought->get_games());
-        buyer->update_players(bought->get_allPlayers());
-        bought->get_allPlayers()->update_team(buyer);
+    if (m_teamIndices.find(teamId) != nullptr) {
+        return StatusType::FAILURE;
     }
-    //If only the buying team has players, update the number of games the players played. No need to change pointers.
-    else if (buyer->get_allPlayers() != nullptr && bought->get_allPlayers() == nullptr) {
-        buyer->get_allPlayers()->update_gamesPlayed(buyer->get_games());
+    int rankKey = rank_key(teamId, 0);
+    if (rankKey == 0) {
+        return StatusType::FAILURE;
     }
-    //Merge the internal fields of the two teams
-    buyer->teams_unite(*bought);
-    //Delete the bought team from the system:
-    bought->update_players(nullptr);
-    remove_team(teamId2);
-    //Fix the location of the united team in the teams by ability tree:
-    m_teamsByAbility.remove(teamId1, prevAbility);
+    int historyId;
     try {
-        m_teamsByAbility.insert(buyer, teamId1, buyer->get_ability());
+        historyId = m_matchHistory.add_team(teamId);
     }
-    catch (std::bad_alloc&) {
+    catch (const std::bad_alloc& e) {
+        return StatusType::ALLOCATION_ERROR;
+    }
+    Team* newTeam;
+    try {
+        newTeam = m_teamSlots.acquire(teamId);
+    }
+    catch (const std::bad_alloc& e) {
+        m_matchHistory.remove_last_team();
+        return StatusType::ALLOCATION_ERROR;
+    }
+    newTeam->update_history_id(historyId);
+    //Every failure below undoes the steps before it, in reverse order
+    try {
+        m_teamIndices.insert(teamId, newTeam);
+    }
+    catch (const std::bad_alloc& e) {
+        m_teamSlots.release(newTeam->get_slot());
+        m_matchHistory.remove_last_team();
+        return StatusType::ALLOCATION_ERROR;
+    }
+    try {
+        m_teamsByID.insert(newTeam, teamId);
+    }
+    catch (const std::bad_alloc& e) {
+        m_teamIndices.remove(teamId);
+        m_teamSlots.release(newTeam->get_slot());
+        m_matchHistory.remove_last_team();
         return StatusType::ALLOCATION_ERROR;
     }
+    //Insert the team into the rank tree:
+    StatusType result = StatusType::SUCCESS;
+    bool ranked = false;
+    try {
+        rank_insert(newTeam, 0, rankKey);
+        ranked = true;
+        m_teamsByScore.insert(newTeam, teamId, 0);
+    }
+    catch (const std::bad_alloc& e) {
+        result = StatusType::ALLOCATION_ERROR;
+    }
+    catch (const InvalidID& e) {
+        result = StatusType::FAILURE;
+    }
+    if (result != StatusType::SUCCESS) {
+        if (ranked) {
+            rank_remove(newTeam, 0);
+        }
+        m_teamsByID.remove(teamId);
+        m_teamIndices.remove(teamId);
+        m_teamSlots.release(newTeam->get_slot());
+        m_matchHistory.remove_last_team();
+        return result;
+    }
+    m_numTeams++;
+    handle = m_teamSlots.get_handle(newTeam->get_slot());
 	return StatusType::SUCCESS;
 }
 
 
-//-------------------------------------------Helper Functions----------------------------------------------
+StatusType world_cup_t::add_player(int playerId, TeamHandle team, const permutation_t& spirit, int gamesPlayed,
+                                   int ability, int cards, bool goalKeeper, PlayerHandle& handle)
+{
+    thaw();
+    if (playerId <= 0 || gamesPlayed < 0 || cards < 0 || !spirit.isvalid()) {
+        return StatusType::INVALID_INPUT;
+    }
+    if (check_player_exists(playerId)) {
+        return StatusType::FAILURE;
+    }
+    Team* tmpTeam = m_teamSlots.get_team(team);
+    if (tmpTeam == nullptr) {
+        return StatusType::FAILURE;
+    }
+    return insert_player(playerId, tmpTeam, spirit, gamesPlayed, ability, cards, goalKeeper, handle);
+}
 
-bool world_cup_t::check_player_exists(int playerId)
+
+output_t<TeamHandle> world_cup_t::resolve_team(int teamId)
 {
-    int arrayIndex = hash_function(playerId);
-    try {
-        m_playersHashTable[arrayIndex]->search_specific_id(playerId);
+    if (teamId <= 0) {
+        return output_t<TeamHandle>(StatusType::INVALID_INPUT);
     }
-    catch (const NodeNotFound& e) {
-        return false;
+    Team** team = m_teamIndices.find(teamId);
+    if (team == nullptr) {
+        return output_t<TeamHandle>(StatusType::FAILURE);
     }
-    return true;
+    return output_t<TeamHandle>(m_teamSlots.get_handle((*team)->get_slot()));
 }
 
 
-bool world_cup_t::check_player_kicked_out(int playerId)
+output_t<PlayerHandle> world_cup_t::resolve_player(int playerId)
 {
-    int arrayIndex = hash_function(playerId);
-    Player* tmpPlayer;
-    try {
-        tmpPlayer = m_playersHashTable[arrayIndex]->search_and_return_data(playerId);
+    if (playerId <= 0) {
+        return output_t<PlayerHandle>(StatusType::INVALID_INPUT);
     }
-    catch (const NodeNotFound& e) {
-        return true;
+    int* playerIndex = m_playerIndices.find(playerId);
+    if (playerIndex == nullptr) {
+        return output_t<PlayerHandle>(StatusType::FAILURE);
     }
-    //Union-find algorithm - compress path from player to root
-    tmpPlayer->find();
-    //Check if the player was disqualified by checking if their root's team is nullptr
-    if ((tmpPlayer->get_parent() == nullptr && tmpPlayer->get_team() == nullptr) || \
-            (tmpPlayer->get_parent() != nullptr && tmpPlayer->get_parent()->get_team() == nullptr)) {
-        return true;
+    PlayerHandle handle;
+    handle.index = *playerIndex;
+    handle.epoch = m_playerTable.get_epoch();
+    return output_t<PlayerHandle>(handle);
+}
+
+
+StatusType world_cup_t::remove_team(TeamHandle team)
+{
+    thaw();
+    Team* removed = m_teamSlots.get_team(team);
+    if (removed == nullptr) {
+        return StatusType::FAILURE;
     }
-    return false;
+    erase_team(removed);
+    return StatusType::SUCCESS;
 }
 
 
-void world_cup_t::enlarge_hash_table()
+output_t<int> world_cup_t::play_match(TeamHandle team1, TeamHandle team2)
 {
-    int newSize = ((m_currentHashSize + 1 ) * 2 ) - 1;
-    Tree<GenericNode<Player*>, Player*>** newTable = new Tree<GenericNode<Player*>, Player*>*[newSize];
-    for (int i = 0; i < newSize; i++) {
-        try {
-            newTable[i] = new Tree<GenericNode<Player*>, Player*>();
-        }
-        catch (const std::bad_alloc& e) {
-            delete[] newTable;
-            throw e;
-        }
+    thaw();
+    if (team1.slot == team2.slot) {
+        return output_t<int>(StatusType::INVALID_INPUT);
     }
-    int arrayIndex = 0;
-    Player** all_players = new Player*[m_currentHashSize];
-    for (int i = 0; i < m_currentHashSize; i++) {
-        all_players[i] = nullptr;
+    Team* first = m_teamSlots.get_team(team1);
+    Team* second = m_teamSlots.get_team(team2);
+    if (first == nullptr || second == nullptr) {
+        return output_t<int>(StatusType::FAILURE);
     }
-    Player** tmpPlayers = all_players;
-    for (int i = 0; i < m_currentHashSize; i++) {
-        m_playersHashTable[i]->get_all_data(all_players);
-        while (*all_players != nullptr) {
-            arrayIndex = (*all_players)->get_playerId() % newSize;
-            newTable[arrayIndex]->insert(*all_players, (*all_players)->get_playerId());
-            all_players++;
-        }
+    return match_teams(first, second);
+}
+
+
+output_t<int> world_cup_t::num_played_games_for_player(PlayerHandle player)
+{
+    if (!is_player(player)) {
+        return output_t<int>(StatusType::FAILURE);
+    }
+    return output_t<int>(player_games(player.index));
+}
+
+
+StatusType world_cup_t::add_player_cards(PlayerHandle player, int cards)
+{
+    thaw();
+    if (cards < 0) {
+        return StatusType::INVALID_INPUT;
+    }
+    if (!is_player(player)) {
+        return StatusType::FAILURE;
+    }
+    return give_player_cards(player.index, cards);
+}
+
+
+output_t<int> world_cup_t::get_player_cards(PlayerHandle player)
+{
+    //The table is up to date even when the world cup is frozen (every write thaws it first)
+    if (!is_player(player)) {
+        return output_t<int>(StatusType::FAILURE);
+    }
+    return output_t<int>(m_playerTable.get_cards(player.index));
+}
+
+
+output_t<int> world_cup_t::get_team_points(TeamHandle team)
+{
+    Team* found = m_teamSlots.get_team(team);
+    if (found == nullptr) {
+        return output_t<int>(StatusType::FAILURE);
     }
-    delete[] tmpPlayers;
-    Tree<GenericNode<Player*>, Player*>** tmpTable = m_playersHashTable;
-    m_playersHashTable = newTable;
-    destroy_old_hash_table(tmpTable);
-    m_currentHashSize = newSize;
+    return output_t<int>(found->get_points());
 }
 
 
-void world_cup_t::destroy_old_hash_table(Tree<GenericNode<Player*>, Player*>** tmpTable)
+output_t<permutation_t> world_cup_t::get_partial_spirit(PlayerHandle player)
 {
-    for (int i = 0; i < m_currentHashSize; i++) {
-        delete tmpTable[i];
+    if (!is_player(player)) {
+        return output_t<permutation_t>(StatusType::FAILURE);
+    }
+    return player_partial_spirit(player.index);
+}
+
+
+StatusType world_cup_t::buy_team(TeamHandle team1, TeamHandle team2)
+{
+    thaw();
+    if (team1.slot == team2.slot) {
+        return StatusType::INVALID_INPUT;
+    }
+    Team* buyer = m_teamSlots.get_team(team1);
+    Team* bought = m_teamSlots.get_team(team2);
+    if (buyer == nullptr || bought == nullptr) {
+        return StatusType::FAILURE;
     }
-    delete[] tmpTable;
+    return unite_teams(buyer, bought);
 }
 
 
-void world_cup_t::insert_player_hash_table(Player* tmpPlayer)
+output_t<int> world_cup_t::export_team_players(TeamHandle team, int* playerIds, int* gamesPlayed,
+                                               permutation_t* partialSpirits, int bufferSize)
 {
-    int arrayIndex = hash_function(tmpPlayer->get_playerId());
-    m_playersHashTable[arrayIndex]->insert(tmpPlayer, tmpPlayer->get_playerId());
+    if (bufferSize < 0 || playerIds == nullptr || gamesPlayed == nullptr || partialSpirits == nullptr) {
+        return output_t<int>(StatusType::INVALID_INPUT);
+    }
+    Team* found = m_teamSlots.get_team(team);
+    if (found == nullptr) {
+        return output_t<int>(StatusType::FAILURE);
+    }
+    return export_players(found, playerIds, gamesPlayed, partialSpirits, bufferSize);
 }
 
 
-int world_cup_t::hash_function(int id)
+output_t<int> world_cup_t::get_team_score_rank(TeamHandle team)
 {
-    return id % m_currentHashSize;
-}
\ No newline at end of file
+    Team* found = m_teamSlots.get_team(team);
+    if (found == nullptr) {
+        return output_t<int>(StatusType::FAILURE);
+    }
+    return output_t<int>(m_teamsByScore.find_rank(found->get_teamID(), found->get_score()));
+}
+
+
+output_t<int> world_cup_t::get_team_cards(TeamHandle team)
+{
+    Team* found = m_teamSlots.get_team(team);
+    if (found == nullptr) {
+        return output_t<int>(StatusType::FAILURE);
+    }
+    return output_t<int>(found->get_total_cards());
+}
+
+
+output_t<int> world_cup_t::get_team_player_games(TeamHandle team)
+{
+    Team* found = m_teamSlots.get_team(team);
+    if (found == nullptr) {
+        return output_t<int>(StatusType::FAILURE);
+    }
+    return output_t<int>(found->get_total_player_games());
+}
+
+
+//-------------------------------------------Helper Functions----------------------------------------------
+
+bool world_cup_t::check_player_exists(int playerId)
+{
+    return m_playerIndices.find(playerId) != nullptr;
+}
+
+
+bool world_cup_t::is_player(const PlayerHandle& player) const
+{
+    return player.epoch == m_playerTable.get_epoch() && player.index >= 0 && player.index < m_playerTable.get_size();
+}
+
+
+void world_cup_t::erase_team(Team* team)
+{
+    int teamId = team->get_teamID();
+    m_teamIndices.remove(teamId);
+    m_teamsByID.remove(teamId);
+    rank_remove(team, team->get_ability());
+    m_teamsByScore.remove(teamId, team->get_score());
+    if (team->get_allPlayers() != PlayerTable::NO_PLAYER) {
+        m_playerTable.update_gamesPlayed(team->get_allPlayers(), team->get_games());
+        m_playerTable.detach(team->get_allPlayers());
+    }
+    m_teamSlots.release(team->get_slot());
+    m_numTeams--;
+}
+
+
+StatusType world_cup_t::insert_player(const int playerId, Team* team, const permutation_t& spirit,
+                                      const int gamesPlayed, const int ability, const int cards,
+                                      const bool goalKeeper, PlayerHandle& handle)
+{
+    int teamId = team->get_teamID();
+    int rankKey = rank_key(teamId, team->get_ability() + ability);
+    if (rankKey == 0) {
+        return StatusType::FAILURE;
+    }
+    //The inputs are okay - continue adding player
+    int playerRoot = team->get_allPlayers();
+    //Correlate the player's games played with the total team games and the root player games played
+    int playerNumGames = gamesPlayed - team->get_games();
+    //If this player isn't the first player on the team
+    if (playerRoot != PlayerTable::NO_PLAYER) {
+        playerNumGames -= m_playerTable.get_gamesPlayed(playerRoot);
+    }
+    //The spirits are saved internally as Spirit (the rank of the permutation)
+    Spirit playerSpirit(spirit);
+    //Add the player's partial spirit-its team's spirit only including the players that joined before the current player
+    Spirit partialSpirit = team->get_teamSpirit();
+    //If this player isn't the first player on the team
+    if (playerRoot != PlayerTable::NO_PLAYER) {
+        //Add the current player's spirit to its partial spirit
+        partialSpirit = partialSpirit * playerSpirit;
+        //Inverse the root's spirit and add it to the player's partial spirit (it will be added back in the future)
+        partialSpirit = m_playerTable.get_partialSpirit(playerRoot).inv() * partialSpirit;
+    }
+    else {
+        partialSpirit = playerSpirit;
+    }
+    int playerIndex;
+    try {
+        playerIndex = m_playerTable.add(playerId, playerNumGames, partialSpirit, playerRoot,
+                                        ability, cards, goalKeeper, playerSpirit);
+    }
+    catch (const std::bad_alloc& e) {
+        return StatusType::ALLOCATION_ERROR;
+    }
+    try {
+        m_playerIndices.insert(playerId, playerIndex);
+    }
+    catch (const std::bad_alloc& e) {
+        m_playerTable.remove_last();
+        return StatusType::ALLOCATION_ERROR;
+    }
+    catch (const InvalidID& e) {
+        m_playerTable.remove_last();
+        return StatusType::FAILURE;
+    }
+    handle.index = playerIndex;
+    handle.epoch = m_playerTable.get_epoch();
+    //If this is the first player in the team, update team pointer to it's players
+    if (playerRoot == PlayerTable::NO_PLAYER) {
+        m_playerTable.update_team(playerIndex, team);
+        team->update_players(playerIndex);
+    }
+    //Remove the team from the tree sorted by player ability, and update the team's stats
+    int prevScore = team->get_score();
+    bool wasValid = team->is_valid();
+    rank_remove(team, team->get_ability());
+    team->add_player(playerSpirit, gamesPlayed, ability, cards, goalKeeper);
+    //Only the first goalkeeper changes the team's validity in the tree of teams by ID
+    if (!wasValid && goalKeeper) {
+        m_teamsByID.update_valid(teamId);
+    }
+    //Re-insert the team from the tree sorted by player ability
+    try {
+        rank_insert(team, team->get_ability(), rankKey);
+        score_update(team, prevScore);
+    }
+    catch (const InvalidID& e) {}
+    catch (const std::bad_alloc& e) {
+        return StatusType::ALLOCATION_ERROR;
+    }
+    m_numTotalPlayers++;
+    return StatusType::SUCCESS;
+}
+
+
+output_t<int> world_cup_t::match_teams(Team* team1, Team* team2)
+{
+    if (!team1->is_valid() || !team2->is_valid()) {
+        return output_t<int>(StatusType::FAILURE);
+    }
+    int score1 = team1->get_score();
+    int score2 = team2->get_score();
+    try {
+        m_matchHistory.reserve(1);
+    }
+    catch (const std::bad_alloc&) {
+        return output_t<int>(StatusType::ALLOCATION_ERROR);
+    }
+    int result = apply_match(team1, team2, m_matchHistory.extend(1));
+    //Fix the location of the teams whose points changed in the tree of teams by score:
+    try {
+        if (result != 3 && result != 4) {
+            score_update(team1, score1);
+        }
+        if (result != 1 && result != 2) {
+            score_update(team2, score2);
+        }
+    }
+    catch (const std::bad_alloc&) {
+        return output_t<int>(StatusType::ALLOCATION_ERROR);
+    }
+	return output_t<int>(result);
+}
+
+
+StatusType world_cup_t::unite_teams(Team* buyer, Team* bought)
+{
+    int prevAbility = buyer->get_ability();
+    int prevScore = buyer->get_score();
+    int rankKey = rank_key(buyer->get_teamID(), prevAbility + bought->get_ability());
+    if (rankKey == 0) {
+        return StatusType::FAILURE;
+    }
+    int buyerRoot = buyer->get_allPlayers();
+    int boughtRoot = bought->get_allPlayers();
+    //If both teams contain players, send to a helper function inside the PlayerTable class:
+    if (buyerRoot != PlayerTable::NO_PLAYER && boughtRoot != PlayerTable::NO_PLAYER) {
+        m_playerTable.update_gamesPlayed(buyerRoot, buyer->get_games());
+        m_playerTable.update_gamesPlayed(boughtRoot, bought->get_games());
+        int root = m_playerTable.players_union(buyerRoot, boughtRoot, buyer->get_num_players(),
+                                        bought->get_num_players(), buyer->get_teamSpirit(), bought->get_teamSpirit());
+        //Update the team and its players according to the output of the helper function above:
+        m_playerTable.update_team(root, buyer);
+        buyer->update_players(root);
+    }
+    //If only the bought team contains players, update the root so that they belong to the buying team:
+    else if (buyerRoot == PlayerTable::NO_PLAYER && boughtRoot != PlayerTable::NO_PLAYER) {
+        m_playerTable.update_gamesPlayed(boughtRoot, bought->get_games());
+        buyer->update_players(boughtRoot);
+        m_playerTable.update_team(boughtRoot, buyer);
+    }
+    //If only the buying team has players, update the number of games the players played. No need to change the root.
+    else if (buyerRoot != PlayerTable::NO_PLAYER && boughtRoot == PlayerTable::NO_PLAYER) {
+        m_playerTable.update_gamesPlayed(buyerRoot, buyer->get_games());
+    }
+    //Merge the internal fields of the two teams
+    bool wasValid = buyer->is_valid();
+    buyer->teams_unite(*bought);
+    if (wasValid != buyer->is_valid()) {
+        m_teamsByID.update_valid(buyer->get_teamID());
+    }
+    //Delete the bought team from the system (it was already found, so it isn't searched again):
+    bought->update_players(PlayerTable::NO_PLAYER);
+    erase_team(bought);
+    //Fix the location of the united team in the teams by ability tree:
+    rank_remove(buyer, prevAbility);
+    try {
+        rank_insert(buyer, buyer->get_ability(), rankKey);
+        score_update(buyer, prevScore);
+    }
+    catch (std::bad_alloc&) {
+        return StatusType::ALLOCATION_ERROR;
+    }
+	return StatusType::SUCCESS;
+}
+
+
+int world_cup_t::player_games(const int index)
+{
+    //Union-find algorithm - find the root and shorten the path from the player to it
+    int gamesPlayed;
+    Spirit playerSpirit;
+    int root = m_playerTable.find(index, gamesPlayed, playerSpirit, m_findPolicy);
+    gamesPlayed += m_playerTable.get_gamesPlayed(root);
+    if (m_playerTable.get_team(root) != nullptr) {
+        gamesPlayed += m_playerTable.get_team(root)->get_games();
+    }
+    return gamesPlayed;
+}
+
+
+output_t<permutation_t> world_cup_t::player_partial_spirit(const int index)
+{
+    //Union-find algorithm - find the root and shorten the path from the player to it
+    int gamesPlayed;
+    Spirit playerSpirit;
+    int root = m_playerTable.find(index, gamesPlayed, playerSpirit, m_findPolicy);
+    //Check if the player was disqualified by checking if their root's team is nullptr
+    if (m_playerTable.get_team(root) == nullptr) {
+        return output_t<permutation_t>(StatusType::FAILURE);
+    }
+    return output_t<permutation_t>((m_playerTable.get_partialSpirit(root) * playerSpirit).to_permutation());
+}
+
+
+StatusType world_cup_t::give_player_cards(const int index, const int cards)
+{
+    //A single find reaches the team, which also tells if the player was disqualified (its team was removed)
+    Team* team = m_playerTable.find_team(index, m_findPolicy);
+    if (team == nullptr) {
+        return StatusType::FAILURE;
+    }
+    m_playerTable.update_cards(index, cards);
+    team->add_cards(cards);
+    return StatusType::SUCCESS;
+}
+
+
+output_t<int> world_cup_t::export_players(Team* team, int* playerIds, int* gamesPlayed, permutation_t* partialSpirits,
+                                          const int bufferSize)
+{
+    int numPlayers = team->get_num_players();
+    if (numPlayers > bufferSize) {
+        return output_t<int>(StatusType::FAILURE);
+    }
+    int root = team->get_allPlayers();
+    if (root == PlayerTable::NO_PLAYER) {
+        return output_t<int>(0);
+    }
+    const int N = permutation_t::N;
+    Spirit* spirits = nullptr;
+    unsigned char* packed = nullptr;
+    try {
+        spirits = new Spirit[numPlayers];
+        packed = new unsigned char[3 * numPlayers * N];
+    }
+    catch (const std::bad_alloc& e) {
+        delete[] spirits;
+        return output_t<int>(StatusType::ALLOCATION_ERROR);
+    }
+    m_playerTable.export_members(root, playerIds, gamesPlayed, spirits);
+    //Add the root's own values once for all of the players: its spirit is composed with all of theirs at once, on the
+    //packed forms, which are already the elements of the permutations that are returned
+    int rootGames = m_playerTable.get_gamesPlayed(root) + team->get_games();
+    Spirit rootSpirit = m_playerTable.get_partialSpirit(root);
+    unsigned char* rootPacked = packed;
+    unsigned char* playersPacked = packed + numPlayers * N;
+    unsigned char* composedPacked = packed + 2 * numPlayers * N;
+    for (int i = 0; i < numPlayers; i++) {
+        rootSpirit.to_packed(rootPacked + i * N);
+        spirits[i].to_packed(playersPacked + i * N);
+    }
+    compose_packed(rootPacked, playersPacked, composedPacked, numPlayers);
+    for (int i = 0; i < numPlayers; i++) {
+        gamesPlayed[i] += rootGames;
+        int elements[N];
+        for (int j = 0; j < N; j++) {
+            elements[j] = composedPacked[i * N + j];
+        }
+        //Build the permutation in the caller's array (permutation_t has no assignment operator of its own)
+        new (&partialSpirits[i]) permutation_t(elements);
+    }
+    delete[] spirits;
+    delete[] packed;
+    return output_t<int>(numPlayers);
+}
+
+
+int world_cup_t::apply_match(Team* team1, Team* team2, const int match)
+{
+    int result = -1;
+    //Find the score for each team, and check for a winner:
+    int score1 = team1->get_score();
+    int score2 = team2->get_score();
+    if (score1 > score2) {
+        team1->update_points_won();
+        result = 1;
+    }
+    else if (score2 > score1) {
+        team2->update_points_won();
+        result = 3;
+    }
+    else {
+        //The teams were tied, so break the tie according to their spirit strength:
+        int spirit1 = team1->get_spirit_strength();
+        int spirit2 = team2->get_spirit_strength();
+        if (spirit1 > spirit2) {
+            team1->update_points_won();
+            result = 2;
+        }
+        else if (spirit2 > spirit1) {
+            team2->update_points_won();
+            result = 4;
+        }
+        else {
+            //The teams were still tied:
+            team1->update_points_tie();
+            team2->update_points_tie();
+            result = 0;
+        }
+    }
+    //Add a game to each of the teams that played, and record the match:
+    team1->add_game();
+    team2->add_game();
+    m_matchHistory.record_at(match, team1, team2, result, score1, score2);
+    return result;
+}
+
+
+int world_cup_t::rank_key(const int teamId, const int ability)
+{
+    if (m_offlineRanks == nullptr) {
+        return 1;
+    }
+    return m_offlineRanks->next_key_position(teamId, ability);
+}
+
+
+void world_cup_t::rank_insert(Team* team, const int ability, const int rankKey)
+{
+    if (m_offlineRanks != nullptr) {
+        m_offlineRanks->insert(rankKey);
+        team->update_rank_key(rankKey);
+        return;
+    }
+    m_teamsByAbility.insert(team, team->get_teamID(), ability);
+}
+
+
+void world_cup_t::rank_remove(Team* team, const int ability)
+{
+    if (m_offlineRanks != nullptr) {
+        m_offlineRanks->remove(team->get_rank_key());
+        return;
+    }
+    m_teamsByAbility.remove(team->get_teamID(), ability);
+}
+
+
+void world_cup_t::score_update(Team* team, const int prevScore)
+{
+    m_teamsByScore.remove(team->get_teamID(), prevScore);
+    m_teamsByScore.insert(team, team->get_teamID(), team->get_score());
+}
+
+
+//-------------------------------------------Offline Mode----------------------------------------------
+
+StatusType world_cup_t::enable_offline_ranks(const int* abilities, const int* teamIds, int numKeys)
+{
+    if (numKeys < 0 || (numKeys > 0 && (abilities == nullptr || teamIds == nullptr))) {
+        return StatusType::INVALID_INPUT;
+    }
+    if (m_numTeams != 0 || m_offlineRanks != nullptr) {
+        return StatusType::FAILURE;
+    }
+    try {
+        m_offlineRanks = new RankFenwick(abilities, teamIds, numKeys);
+    }
+    catch (const std::bad_alloc& e) {
+        return StatusType::ALLOCATION_ERROR;
+    }
+    return StatusType::SUCCESS;
+}
+
+
+StatusType world_cup_t::get_ith_pointless_abilities(const int* indices, int numIndices, int* teamIds)
+{
+    if (numIndices < 0 || (numIndices > 0 && (indices == nullptr || teamIds == nullptr))) {
+        return StatusType::INVALID_INPUT;
+    }
+    for (int j = 1; j < numIndices; j++) {
+        if (indices[j] < indices[j - 1]) {
+            return StatusType::INVALID_INPUT;
+        }
+    }
+    if (numIndices > 0 && (indices[0] < 0 || indices[numIndices - 1] >= m_numTeams)) {
+        return StatusType::FAILURE;
+    }
+    if (m_offlineRanks != nullptr) {
+        for (int j = 0; j < numIndices; j++) {
+            teamIds[j] = m_offlineRanks->find_index(indices[j]);
+        }
+        return StatusType::SUCCESS;
+    }
+    Team** teams;
+    try {
+        teams = new Team*[numIndices + 1];
+    }
+    catch (const std::bad_alloc& e) {
+        return StatusType::ALLOCATION_ERROR;
+    }
+    m_teamsByAbility.find_indices(indices, numIndices, teams);
+    for (int j = 0; j < numIndices; j++) {
+        teamIds[j] = teams[j]->get_teamID();
+    }
+    delete[] teams;
+    return StatusType::SUCCESS;
+}
+
+
+//-------------------------------------------Score Leaderboard----------------------------------------------
+
+output_t<int> world_cup_t::get_ith_team_by_score(int i)
+{
+    if (i < 0 || m_numTeams == 0 || i >= m_numTeams) {
+        return output_t<int>(StatusType::FAILURE);
+    }
+    Team* team = m_teamsByScore.find_index(m_teamsByScore.m_node, i)->get_data();
+    return output_t<int>(team->get_teamID());
+}
+
+
+output_t<int> world_cup_t::get_team_score_rank(int teamId)
+{
+    if (teamId <= 0) {
+        return output_t<int>(StatusType::INVALID_INPUT);
+    }
+    Team* team;
+    try {
+        team = m_teamIndices.search_and_return_data(teamId);
+    }
+    catch (const NodeNotFound& e) {
+        return output_t<int>(StatusType::FAILURE);
+    }
+    return output_t<int>(m_teamsByScore.find_rank(teamId, team->get_score()));
+}
+
+
+output_t<int> world_cup_t::knockout_winner(int minTeamId, int maxTeamId)
+{
+    if (minTeamId <= 0 || maxTeamId <= 0 || maxTeamId < minTeamId) {
+        return output_t<int>(StatusType::INVALID_INPUT);
+    }
+    int numTeams = m_teamsByID.count_valid(minTeamId, maxTeamId);
+    if (numTeams == 0) {
+        return output_t<int>(StatusType::FAILURE);
+    }
+    Team** teams = nullptr;
+    long long* scores = nullptr;
+    try {
+        teams = new Team*[numTeams];
+        scores = new long long[numTeams];
+    }
+    catch (const std::bad_alloc& e) {
+        delete[] teams;
+        return output_t<int>(StatusType::ALLOCATION_ERROR);
+    }
+    m_teamsByID.get_valid_in_range(minTeamId, maxTeamId, teams);
+    for (int i = 0; i < numTeams; i++) {
+        scores[i] = teams[i]->get_score();
+    }
+    //Play the rounds in place: the winner of the pair (i, i+1) moves to index i/2
+    while (numTeams > 1) {
+        for (int i = 0; i + 1 < numTeams; i += 2) {
+            bool firstWins = scores[i] > scores[i + 1];
+            if (scores[i] == scores[i + 1]) {
+                int spirit1 = teams[i]->get_spirit_strength();
+                int spirit2 = teams[i + 1]->get_spirit_strength();
+                firstWins = spirit1 > spirit2 ||
+                            (spirit1 == spirit2 && teams[i]->get_teamID() > teams[i + 1]->get_teamID());
+            }
+            teams[i / 2] = firstWins ? teams[i] : teams[i + 1];
+            scores[i / 2] = scores[i] + scores[i + 1] + 3;
+        }
+        if (numTeams % 2 == 1) {
+            teams[numTeams / 2] = teams[numTeams - 1];
+            scores[numTeams / 2] = scores[numTeams - 1];
+        }
+        numTeams = (numTeams + 1) / 2;
+    }
+    int winner = teams[0]->get_teamID();
+    delete[] teams;
+    delete[] scores;
+    return output_t<int>(winner);
+}
+
+
+//-----------------------------------------------Freeze Mode------------------------------------------------
+
+StatusType world_cup_t::freeze()
+{
+    if (m_frozen != nullptr) {
+        return StatusType::SUCCESS;
+    }
+    Team** teams = nullptr;
+    int* teamIds = nullptr;
+    int* teamPoints = nullptr;
+    int* indices = nullptr;
+    int* rankedTeamIds = nullptr;
+    int* playerIds = nullptr;
+    int* playerCards = nullptr;
+    StatusType result = StatusType::SUCCESS;
+    try {
+        teams = new Team*[m_numTeams + 1];
+        teamIds = new int[m_numTeams + 1];
+        teamPoints = new int[m_numTeams + 1];
+        indices = new int[m_numTeams + 1];
+        rankedTeamIds = new int[m_numTeams + 1];
+        playerIds = new int[m_playerTable.get_size() + 1];
+        playerCards = new int[m_playerTable.get_size() + 1];
+        //The teams sorted by ID:
+        m_teamsByID.get_all_data(teams);
+        for (int i = 0; i < m_numTeams; i++) {
+            teamIds[i] = teams[i]->get_teamID();
+            teamPoints[i] = teams[i]->get_points();
+            indices[i] = i;
+        }
+        //The teams sorted by ability:
+        result = get_ith_pointless_abilities(indices, m_numTeams, rankedTeamIds);
+        //All of the players, by their index:
+        int numPlayers = m_playerTable.get_size();
+        for (int i = 0; i < numPlayers; i++) {
+            playerIds[i] = m_playerTable.get_playerId(i);
+            playerCards[i] = m_playerTable.get_cards(i);
+        }
+        if (result == StatusType::SUCCESS) {
+            m_frozen = new FrozenSnapshot(teamIds, teamPoints, rankedTeamIds, m_numTeams,
+                                          playerIds, playerCards, numPlayers);
+        }
+    }
+    catch (const std::bad_alloc& e) {
+        result = StatusType::ALLOCATION_ERROR;
+    }
+    delete[] teams;
+    delete[] teamIds;
+    delete[] teamPoints;
+    delete[] indices;
+    delete[] rankedTeamIds;
+    delete[] playerIds;
+    delete[] playerCards;
+    return result;
+}
+
+
+void world_cup_t::set_find_policy(FindPolicy policy)
+{
+    m_findPolicy = policy;
+}
+
+
+void world_cup_t::thaw()
+{
+    delete m_frozen;
+    m_frozen = nullptr;
+}
+
+
+//-------------------------------------------Rosters----------------------------------------------
+
+output_t<int> world_cup_t::export_team_players(int teamId, int* playerIds, int* gamesPlayed,
+                                               permutation_t* partialSpirits, int bufferSize)
+{
+    if (teamId <= 0 || bufferSize < 0 || playerIds == nullptr || gamesPlayed == nullptr || partialSpirits == nullptr) {
+        return output_t<int>(StatusType::INVALID_INPUT);
+    }
+    Team* team;
+    try {
+        team = m_teamIndices.search_and_return_data(teamId);
+    }
+    catch (const NodeNotFound& e) {
+        return output_t<int>(StatusType::FAILURE);
+    }
+    return export_players(team, playerIds, gamesPlayed, partialSpirits, bufferSize);
+}
+
+
+output_t<int> world_cup_t::get_team_cards(int teamId)
+{
+    if (teamId <= 0) {
+        return output_t<int>(StatusType::INVALID_INPUT);
+    }
+    Team* team;
+    try {
+        team = m_teamIndices.search_and_return_data(teamId);
+    }
+    catch (const NodeNotFound& e) {
+        return output_t<int>(StatusType::FAILURE);
+    }
+    return output_t<int>(team->get_total_cards());
+}
+
+
+output_t<int> world_cup_t::get_team_player_games(int teamId)
+{
+    if (teamId <= 0) {
+        return output_t<int>(StatusType::INVALID_INPUT);
+    }
+    Team* team;
+    try {
+        team = m_teamIndices.search_and_return_data(teamId);
+    }
+    catch (const NodeNotFound& e) {
+        return output_t<int>(StatusType::FAILURE);
+    }
+    return output_t<int>(team->get_total_player_games());
+}
+
+
+//-------------------------------------------Union-Find Stats----------------------------------------------
+
+const UnionFindStats& world_cup_t::get_union_find_stats() const
+{
+    return m_playerTable.get_stats();
+}
+
+
+void world_cup_t::reset_union_find_stats()
+{
+    m_playerTable.reset_stats();
+}
+
+
+//-------------------------------------------Match Days----------------------------------------------
+
+StatusType world_cup_t::play_matches(const int* teamIds1, const int* teamIds2, int numMatches, int* results,
+                                     StatusType* statuses)
+{
+    thaw();
+    if (numMatches < 0 || (numMatches > 0 && (teamIds1 == nullptr || teamIds2 == nullptr || results == nullptr ||
+                                              statuses == nullptr))) {
+        return StatusType::INVALID_INPUT;
+    }
+    //Every match has two slots: slot 2i is the first team of match i, and slot 2i+1 is the second
+    int numSlots = 2 * numMatches;
+    int* slotTeams = nullptr;
+    int* teamIds = nullptr;
+    Team** teams = nullptr;
+    int* firstScores = nullptr;
+    int* places = nullptr;
+    int* lastRounds = nullptr;
+    int* matchRounds = nullptr;
+    int* rounds = nullptr;
+    int* order = nullptr;
+    StatusType result = StatusType::SUCCESS;
+    try {
+        slotTeams = new int[numSlots + 1];
+        teamIds = new int[numSlots + 1];
+        teams = new Team*[numSlots + 1];
+        firstScores = new int[numSlots + 1];
+        places = new int[numMatches + 1];
+        lastRounds = new int[numSlots + 1];
+        matchRounds = new int[numMatches + 1];
+        rounds = new int[numMatches + 2];
+        order = new int[numMatches + 1];
+        //Give every distinct team ID of the day a local index:
+        HashIndex<int> localIndices;
+        localIndices.reserve(numSlots);
+        int numTeams = 0;
+        for (int i = 0; i < numSlots; i++) {
+            int id = (i % 2 == 0) ? teamIds1[i / 2] : teamIds2[i / 2];
+            if (id <= 0) {
+                slotTeams[i] = -1;
+                continue;
+            }
+            int* localIndex = localIndices.find(id);
+            if (localIndex == nullptr) {
+                localIndices.insert(id, numTeams);
+                teamIds[numTeams] = id;
+                numTeams++;
+                localIndex = localIndices.find(id);
+            }
+            slotTeams[i] = *localIndex;
+        }
+        //Search every distinct team once:
+        for (int i = 0; i < numTeams; i++) {
+            Team** team = m_teamIndices.find(teamIds[i]);
+            teams[i] = (team == nullptr) ? nullptr : *team;
+            if (teams[i] != nullptr) {
+                firstScores[i] = teams[i]->get_score();
+            }
+        }
+        //Check every match before playing any (the teams, and whether they can play, don't change during the day),
+        //and give every match that is played its place in the match history, in the order of the matches
+        m_matchHistory.reserve(numMatches);
+        int numPlayed = 0;
+        for (int i = 0; i < numMatches; i++) {
+            results[i] = -1;
+            if (teamIds1[i] <= 0 || teamIds2[i] <= 0 || teamIds1[i] == teamIds2[i]) {
+                statuses[i] = StatusType::INVALID_INPUT;
+                continue;
+            }
+            Team* team1 = teams[slotTeams[2 * i]];
+            Team* team2 = teams[slotTeams[2 * i + 1]];
+            if (team1 == nullptr || team2 == nullptr || !team1->is_valid() || !team2->is_valid()) {
+                statuses[i] = StatusType::FAILURE;
+                continue;
+            }
+            statuses[i] = StatusType::SUCCESS;
+            places[i] = numPlayed++;
+        }
+        int numRounds = partition_rounds(slotTeams, statuses, numMatches, numTeams, lastRounds, matchRounds, rounds,
+                                         order);
+        //Play the rounds in order: a team's score depends on its earlier matches of the day, which are all in
+        //earlier rounds, and the matches of a round share no team
+        int firstPlace = m_matchHistory.extend(numPlayed);
+        for (int r = 0; r < numRounds; r++) {
+#ifdef WORLDCUP_PARALLEL_ROUNDS
+            #pragma omp parallel for schedule(static)
+#endif
+            for (int k = rounds[r]; k < rounds[r + 1]; k++) {
+                int i = order[k];
+                results[i] = apply_match(teams[slotTeams[2 * i]], teams[slotTeams[2 * i + 1]], firstPlace + places[i]);
+            }
+        }
+        //Fix the location of the teams whose points changed in the tree of teams by score, once per team:
+        for (int i = 0; i < numTeams; i++) {
+            if (teams[i] != nullptr && teams[i]->get_score() != firstScores[i]) {
+                score_update(teams[i], firstScores[i]);
+            }
+        }
+    }
+    catch (const std::bad_alloc& e) {
+        result = StatusType::ALLOCATION_ERROR;
+    }
+    delete[] slotTeams;
+    delete[] teamIds;
+    delete[] teams;
+    delete[] firstScores;
+    delete[] places;
+    delete[] lastRounds;
+    delete[] matchRounds;
+    delete[] rounds;
+    delete[] order;
+    return result;
+}
+
+
+int world_cup_t::partition_rounds(const int* slotTeams, const StatusType* statuses, const int numMatches,
+                                  const int numTeams, int* lastRounds, int* matchRounds, int* roundStarts, int* order)
+{
+    //The round of a match is the round after the last round of its two teams (the round of the team's previous
+    //match of the day)
+    for (int t = 0; t < numTeams; t++) {
+        lastRounds[t] = -1;
+    }
+    int numRounds = 0;
+    for (int i = 0; i < numMatches; i++) {
+        if (statuses[i] != StatusType::SUCCESS) {
+            continue;
+        }
+        int team1 = slotTeams[2 * i];
+        int team2 = slotTeams[2 * i + 1];
+        int round = ((lastRounds[team1] > lastRounds[team2]) ? lastRounds[team1] : lastRounds[team2]) + 1;
+        lastRounds[team1] = round;
+        lastRounds[team2] = round;
+        matchRounds[i] = round;
+        numRounds = (round >= numRounds) ? round + 1 : numRounds;
+    }
+    //Counting sort of the matches by their rounds, which keeps the order of the matches inside every round
+    for (int r = 0; r <= numRounds; r++) {
+        roundStarts[r] = 0;
+    }
+    for (int i = 0; i < numMatches; i++) {
+        if (statuses[i] == StatusType::SUCCESS) {
+            roundStarts[matchRounds[i] + 1]++;
+        }
+    }
+    for (int r = 0; r < numRounds; r++) {
+        roundStarts[r + 1] += roundStarts[r];
+    }
+    //Every match is placed at the next free position of its round, which moves the start of the round to its end
+    for (int i = 0; i < numMatches; i++) {
+        if (statuses[i] == StatusType::SUCCESS) {
+            order[roundStarts[matchRounds[i]]++] = i;
+        }
+    }
+    for (int r = numRounds; r > 0; r--) {
+        roundStarts[r] = roundStarts[r - 1];
+    }
+    roundStarts[0] = 0;
+    return numRounds;
+}
+
+
+//-------------------------------------------Season Simulation----------------------------------------------
+
+output_t<int> world_cup_t::simulate_season(int* teamIds, int* points, int bufferSize, SeasonKernel kernel)
+{
+    if (teamIds == nullptr || points == nullptr || bufferSize < 0) {
+        return output_t<int>(StatusType::INVALID_INPUT);
+    }
+    const int maxTeamId = 0x7fffffff;
+    int numTeams = m_teamsByID.count_valid(1, maxTeamId);
+    if (numTeams > bufferSize) {
+        return output_t<int>(StatusType::FAILURE);
+    }
+    Team** teams = nullptr;
+    int* abilities = nullptr;
+    int* strengths = nullptr;
+    SeasonSimulator* season = nullptr;
+    StatusType result = StatusType::SUCCESS;
+    try {
+        teams = new Team*[numTeams + 1];
+        abilities = new int[numTeams + 1];
+        strengths = new int[numTeams + 1];
+        //The snapshot of the valid teams, sorted by ID (the buffers hold it until the season is over):
+        m_teamsByID.get_valid_in_range(1, maxTeamId, teams);
+        for (int i = 0; i < numTeams; i++) {
+            teamIds[i] = teams[i]->get_teamID();
+            points[i] = teams[i]->get_points();
+            abilities[i] = teams[i]->get_ability();
+            strengths[i] = teams[i]->get_spirit_strength();
+        }
+        season = new SeasonSimulator(teamIds, points, abilities, strengths, numTeams);
+        season->play_season(kernel);
+        season->get_standings(teamIds, points);
+    }
+    catch (const std::bad_alloc& e) {
+        result = StatusType::ALLOCATION_ERROR;
+    }
+    delete[] teams;
+    delete[] abilities;
+    delete[] strengths;
+    delete season;
+    if (result != StatusType::SUCCESS) {
+        return output_t<int>(result);
+    }
+    return output_t<int>(numTeams);
+}
+
+
+//-------------------------------------------Bulk Operations----------------------------------------------
+
+StatusType world_cup_t::buy_teams(int buyerId, const int* boughtIds, int numBought)
+{
+    thaw();
+    if (buyerId <= 0 || numBought < 0 || (numBought > 0 && boughtIds == nullptr)) {
+        return StatusType::INVALID_INPUT;
+    }
+    for (int i = 0; i < numBought; i++) {
+        if (boughtIds[i] <= 0 || boughtIds[i] == buyerId) {
+            return StatusType::INVALID_INPUT;
+        }
+    }
+    Team** found = m_teamIndices.find(buyerId);
+    if (found == nullptr) {
+        return StatusType::FAILURE;
+    }
+    if (numBought == 0) {
+        return StatusType::SUCCESS;
+    }
+    Team* buyer = *found;
+    Team** bought = nullptr;
+    int* roots = nullptr;
+    int* numPlayers = nullptr;
+    Spirit* spirits = nullptr;
+    unsigned char* packed = nullptr;
+    StatusType result = StatusType::SUCCESS;
+    try {
+        bought = new Team*[numBought + 1];
+        roots = new int[numBought + 1];
+        numPlayers = new int[numBought + 1];
+        spirits = new Spirit[numBought + 1];
+        packed = new unsigned char[3 * (numBought + 1) * permutation_t::N];
+        //Find all of the bought teams before changing anything (a missing or repeating team fails the whole buy)
+        HashIndex<int> seen;
+        seen.reserve(numBought);
+        int totalAbility = buyer->get_ability();
+        for (int i = 0; i < numBought; i++) {
+            found = m_teamIndices.find(boughtIds[i]);
+            if (found == nullptr) {
+                result = StatusType::FAILURE;
+                break;
+            }
+            seen.insert(boughtIds[i], i);
+            bought[i] = *found;
+            totalAbility += bought[i]->get_ability();
+        }
+        int rankKey = (result == StatusType::SUCCESS) ? rank_key(buyerId, totalAbility) : 0;
+        if (result == StatusType::SUCCESS && rankKey == 0) {
+            result = StatusType::FAILURE;
+        }
+        if (result == StatusType::SUCCESS) {
+            //The players of the teams, in the order of the buys, with the games of their teams folded into the roots
+            int numTrees = 0;
+            for (int i = -1; i < numBought; i++) {
+                Team* team = (i < 0) ? buyer : bought[i];
+                if (team->get_allPlayers() != PlayerTable::NO_PLAYER) {
+                    m_playerTable.update_gamesPlayed(team->get_allPlayers(), team->get_games());
+                    roots[numTrees] = team->get_allPlayers();
+                    numPlayers[numTrees] = team->get_num_players();
+                    spirits[numTrees] = team->get_teamSpirit();
+                    numTrees++;
+                }
+            }
+            if (numTrees > 0) {
+                int root = m_playerTable.players_union_all(roots, numPlayers, spirits, numTrees, packed);
+                m_playerTable.update_team(root, buyer);
+                buyer->update_players(root);
+            }
+            //Merge the internal fields of the teams, and delete the bought teams from the system
+            int prevAbility = buyer->get_ability();
+            int prevScore = buyer->get_score();
+            bool wasValid = buyer->is_valid();
+            for (int i = 0; i < numBought; i++) {
+                buyer->teams_unite(*bought[i]);
+                bought[i]->update_players(PlayerTable::NO_PLAYER);
+                erase_team(bought[i]);
+            }
+            if (wasValid != buyer->is_valid()) {
+                m_teamsByID.update_valid(buyerId);
+            }
+            //Fix the location of the united team in the teams by ability and by score trees, once:
+            rank_remove(buyer, prevAbility);
+            rank_insert(buyer, buyer->get_ability(), rankKey);
+            score_update(buyer, prevScore);
+        }
+    }
+    catch (const InvalidID& e) {
+        result = StatusType::FAILURE;
+    }
+    catch (const std::bad_alloc& e) {
+        result = StatusType::ALLOCATION_ERROR;
+    }
+    delete[] bought;
+    delete[] roots;
+    delete[] numPlayers;
+    delete[] spirits;
+    delete[] packed;
+    return result;
+}
+
+
+StatusType world_cup_t::add_players(int teamId, const PlayerSpec* players, int numPlayers)
+{
+    thaw();
+    if (teamId <= 0 || numPlayers < 0 || (numPlayers > 0 && players == nullptr)) {
+        return StatusType::INVALID_INPUT;
+    }
+    for (int i = 0; i < numPlayers; i++) {
+        const PlayerSpec& player = players[i];
+        if (player.playerId <= 0 || player.gamesPlayed < 0 || player.cards < 0 || !player.spirit.isvalid()) {
+            return StatusType::INVALID_INPUT;
+        }
+    }
+    Team** found = m_teamIndices.find(teamId);
+    if (found == nullptr) {
+        return StatusType::FAILURE;
+    }
+    if (numPlayers == 0) {
+        return StatusType::SUCCESS;
+    }
+    Team* team = *found;
+    Spirit* spirits = nullptr;
+    StatusType result = StatusType::SUCCESS;
+    try {
+        spirits = new Spirit[numPlayers];
+        //Check every player before adding any of them (an existing or repeating player ID fails the whole squad)
+        HashIndex<int> seen;
+        seen.reserve(numPlayers);
+        int totalAbility = 0;
+        int totalCards = 0;
+        int totalGames = 0;
+        int numGoalkeepers = 0;
+        for (int i = 0; i < numPlayers; i++) {
+            if (check_player_exists(players[i].playerId)) {
+                result = StatusType::FAILURE;
+                break;
+            }
+            seen.insert(players[i].playerId, i);
+            spirits[i] = Spirit(players[i].spirit);
+            totalAbility += players[i].ability;
+            totalCards += players[i].cards;
+            totalGames += players[i].gamesPlayed;
+            numGoalkeepers += players[i].goalKeeper ? 1 : 0;
+        }
+        int rankKey = (result == StatusType::SUCCESS) ? rank_key(teamId, team->get_ability() + totalAbility) : 0;
+        if (result == StatusType::SUCCESS && rankKey == 0) {
+            result = StatusType::FAILURE;
+        }
+        if (result == StatusType::SUCCESS) {
+            //Make room for all of the players first, so that adding them can't fail halfway
+            m_playerTable.reserve(m_playerTable.get_size() + numPlayers);
+            m_playerIndices.reserve(m_playerIndices.get_size() + numPlayers);
+            int root = team->get_allPlayers();
+            int first = 0;
+            //The first player of an empty team becomes the root (with its own spirit)
+            if (root == PlayerTable::NO_PLAYER) {
+                root = m_playerTable.add(players[0].playerId, players[0].gamesPlayed - team->get_games(), spirits[0],
+                                         PlayerTable::NO_PLAYER, players[0].ability, players[0].cards,
+                                         players[0].goalKeeper, spirits[0]);
+                m_playerIndices.insert(players[0].playerId, root);
+                m_playerTable.update_team(root, team);
+                team->update_players(root);
+                first = 1;
+            }
+            //Every other player is attached to the root, with the team's spirit up to and including the player
+            //(the product of the spirits is built once), relative to the root's spirit
+            int rootGames = team->get_games() + m_playerTable.get_gamesPlayed(root);
+            Spirit rootInverse = m_playerTable.get_partialSpirit(root).inv();
+            Spirit prefix = (first == 1) ? spirits[0] : team->get_teamSpirit();
+            for (int i = first; i < numPlayers; i++) {
+                prefix = prefix * spirits[i];
+                int index = m_playerTable.add(players[i].playerId, players[i].gamesPlayed - rootGames,
+                                              rootInverse * prefix, root, players[i].ability, players[i].cards,
+                                              players[i].goalKeeper, spirits[i]);
+                m_playerIndices.insert(players[i].playerId, index);
+            }
+            //Update the team's stats, and move it in the trees of teams by ability and by score, once
+            Spirit squadSpirit = spirits[0];
+            for (int i = 1; i < numPlayers; i++) {
+                squadSpirit = squadSpirit * spirits[i];
+            }
+            int prevAbility = team->get_ability();
+            int prevScore = team->get_score();
+            bool wasValid = team->is_valid();
+            team->add_players(numPlayers, squadSpirit, totalGames, totalAbility, totalCards, numGoalkeepers);
+            if (wasValid != team->is_valid()) {
+                m_teamsByID.update_valid(teamId);
+            }
+            rank_remove(team, prevAbility);
+            rank_insert(team, team->get_ability(), rankKey);
+            score_update(team, prevScore);
+            m_numTotalPlayers += numPlayers;
+        }
+    }
+    catch (const InvalidID& e) {
+        result = StatusType::FAILURE;
+    }
+    catch (const std::bad_alloc& e) {
+        result = StatusType::ALLOCATION_ERROR;
+    }
+    delete[] spirits;
+    return result;
+}
+
+
+StatusType world_cup_t::remove_teams(const int* teamIds, int numTeams)
+{
+    thaw();
+    if (numTeams < 0 || (numTeams > 0 && teamIds == nullptr)) {
+        return StatusType::INVALID_INPUT;
+    }
+    for (int i = 0; i < numTeams; i++) {
+        if (teamIds[i] <= 0) {
+            return StatusType::INVALID_INPUT;
+        }
+    }
+    if (numTeams == 0) {
+        return StatusType::SUCCESS;
+    }
+    int* sortedIds = nullptr;
+    Team** teams = nullptr;
+    int* roots = nullptr;
+    StatusType result = StatusType::SUCCESS;
+    try {
+        sortedIds = new int[numTeams];
+        teams = new Team*[numTeams];
+        roots = new int[numTeams];
+        //Sort the IDs, so that a repeating ID is next to itself, and the teams are removed from the trees in order
+        for (int i = 0; i < numTeams; i++) {
+            sortedIds[i] = teamIds[i];
+        }
+        sort_array(sortedIds, numTeams, [](const int a, const int b) { return a < b; });
+        //Find all of the teams before changing anything (a missing or repeating team fails the whole removal)
+        for (int i = 0; i < numTeams && result == StatusType::SUCCESS; i++) {
+            Team** found = m_teamIndices.find(sortedIds[i]);
+            if (found == nullptr || (i > 0 && sortedIds[i] == sortedIds[i - 1])) {
+                result = StatusType::FAILURE;
+            }
+            else {
+                teams[i] = *found;
+            }
+        }
+        bool rebuild = numTeams * REBUILD_RATIO >= m_numTeams;
+        HashIndex<int> removed;
+        if (result == StatusType::SUCCESS && rebuild) {
+            removed.reserve(numTeams);
+            for (int i = 0; i < numTeams; i++) {
+                removed.insert(sortedIds[i], i);
+            }
+        }
+        if (result == StatusType::SUCCESS) {
+            //The players of all of the teams keep the games of their teams, and lose their teams together
+            int numRoots = 0;
+            for (int i = 0; i < numTeams; i++) {
+                if (teams[i]->get_allPlayers() != PlayerTable::NO_PLAYER) {
+                    m_playerTable.update_gamesPlayed(teams[i]->get_allPlayers(), teams[i]->get_games());
+                    roots[numRoots++] = teams[i]->get_allPlayers();
+                }
+            }
+            m_playerTable.detach_all(roots, numRoots);
+            //Remove the teams from the trees: one by one if only a few of them go, else rebuild the trees from the
+            //remaining teams
+            for (int i = 0; i < numTeams; i++) {
+                m_teamIndices.remove(sortedIds[i]);
+                if (!rebuild) {
+                    m_teamsByID.remove(sortedIds[i]);
+                    m_teamsByScore.remove(sortedIds[i], teams[i]->get_score());
+                }
+                if (!rebuild || m_offlineRanks != nullptr) {
+                    rank_remove(teams[i], teams[i]->get_ability());
+                }
+            }
+            if (rebuild) {
+                auto isRemoved = [&removed](const int teamId) { return removed.find(teamId) != nullptr; };
+                m_teamsByID.remove_if(isRemoved);
+                m_teamsByScore.remove_if(isRemoved);
+                if (m_offlineRanks == nullptr) {
+                    m_teamsByAbility.remove_if(isRemoved);
+                }
+            }
+            for (int i = 0; i < numTeams; i++) {
+                m_teamSlots.release(teams[i]->get_slot());
+            }
+            m_numTeams -= numTeams;
+        }
+    }
+    catch (const InvalidID& e) {
+        result = StatusType::FAILURE;
+    }
+    catch (const std::bad_alloc& e) {
+        result = StatusType::ALLOCATION_ERROR;
+    }
+    delete[] sortedIds;
+    delete[] teams;
+    delete[] roots;
+    return result;
+}
+
+
+//-------------------------------------------Match History----------------------------------------------
+
+output_t<int> world_cup_t::get_last_matches(int teamId, int numMatches, MatchRecord* matches)
+{
+    if (teamId <= 0 || numMatches < 0 || (numMatches > 0 && matches == nullptr)) {
+        return output_t<int>(StatusType::INVALID_INPUT);
+    }
+    Team** team = m_teamIndices.find(teamId);
+    if (team == nullptr) {
+        return output_t<int>(StatusType::FAILURE);
+    }
+    return output_t<int>(m_matchHistory.get_last_matches(*team, numMatches, matches));
+}
+
+
+StatusType world_cup_t::get_head_to_head(int teamId1, int teamId2, HeadToHead& record)
+{
+    if (teamId1 <= 0 || teamId2 <= 0 || teamId1 == teamId2) {
+        return StatusType::INVALID_INPUT;
+    }
+    Team** team1 = m_teamIndices.find(teamId1);
+    Team** team2 = m_teamIndices.find(teamId2);
+    if (team1 == nullptr || team2 == nullptr) {
+        return StatusType::FAILURE;
+    }
+    try {
+        record = m_matchHistory.get_head_to_head(*team1, *team2);
+    }
+    catch (const std::bad_alloc& e) {
+        return StatusType::ALLOCATION_ERROR;
+    }
+    return StatusType::SUCCESS;
+}
+
+
+//-------------------------------------------Merge----------------------------------------------
+
+StatusType world_cup_t::merge_from(world_cup_t&& other)
+{
+    thaw();
+    if (&other == this) {
+        return StatusType::INVALID_INPUT;
+    }
+    //The offline rank keys were only given for the teams of one world_cup
+    if (m_offlineRanks != nullptr || other.m_offlineRanks != nullptr) {
+        return StatusType::FAILURE;
+    }
+    other.thaw();
+    int numPlayers = other.m_playerTable.get_size();
+    int numTeams = other.m_numTeams;
+    Team** teams = nullptr;
+    RangeNode<Team*>* emptyById = nullptr;
+    ComplexNode<Team*>* emptyByAbility = nullptr;
+    ComplexNode<Team*>* emptyByScore = nullptr;
+    StatusType result = StatusType::SUCCESS;
+    try {
+        teams = new Team*[numTeams + 1];
+        other.m_teamsByID.get_all_data(teams);
+        //Check every ID before changing anything (an ID in both world_cups fails the whole merge)
+        for (int i = 0; i < numPlayers && result == StatusType::SUCCESS; i++) {
+            if (check_player_exists(other.m_playerTable.get_playerId(i))) {
+                result = StatusType::FAILURE;
+            }
+        }
+        for (int i = 0; i < numTeams && result == StatusType::SUCCESS; i++) {
+            if (m_teamIndices.find(teams[i]->get_teamID()) != nullptr) {
+                result = StatusType::FAILURE;
+            }
+        }
+        if (result == StatusType::SUCCESS) {
+            //Make room for everything first, so that the merge can't fail halfway
+            emptyById = new RangeNode<Team*>();
+            emptyByAbility = new ComplexNode<Team*>();
+            emptyByScore = new ComplexNode<Team*>();
+            m_playerTable.reserve(m_playerTable.get_size() + numPlayers);
+            m_playerIndices.reserve(m_playerIndices.get_size() + numPlayers);
+            m_teamIndices.reserve(m_teamIndices.get_size() + numTeams);
+            m_teamSlots.reserve(numTeams);
+            m_matchHistory.reserve(other.m_matchHistory.get_size());
+            m_matchHistory.reserve_teams(other.m_matchHistory.get_num_teams());
+        }
+    }
+    catch (const std::bad_alloc& e) {
+        result = StatusType::ALLOCATION_ERROR;
+    }
+    if (result != StatusType::SUCCESS) {
+        delete[] teams;
+        delete emptyById;
+        delete emptyByAbility;
+        delete emptyByScore;
+        return result;
+    }
+    //Append the players and the matches, shifted by the ones this world_cup already has
+    int playerOffset = m_playerTable.get_size();
+    int historyOffset = m_matchHistory.get_num_teams();
+    int matchOffset = m_matchHistory.get_size();
+    m_playerTable.append(other.m_playerTable);
+    for (int i = 0; i < numPlayers; i++) {
+        m_playerIndices.insert(m_playerTable.get_playerId(playerOffset + i), playerOffset + i);
+    }
+    m_matchHistory.append(other.m_matchHistory);
+    //Move every team to a slot of this world_cup
+    for (int i = 0; i < numTeams; i++) {
+        Team* team = m_teamSlots.acquire(teams[i]->get_teamID());
+        team->take_over(*teams[i], playerOffset, historyOffset, matchOffset);
+        m_teamIndices.insert(team->get_teamID(), team);
+        if (team->get_allPlayers() != PlayerTable::NO_PLAYER) {
+            m_playerTable.update_team(team->get_allPlayers(), team);
+        }
+    }
+    //Merge the trees of teams, pointing the moved nodes to the moved teams
+    auto moved = [this](Team*& team) { team = *m_teamIndices.find(team->get_teamID()); };
+    m_teamsByID.merge_from(other.m_teamsByID, moved, emptyById);
+    m_teamsByAbility.merge_from(other.m_teamsByAbility, moved, emptyByAbility);
+    m_teamsByScore.merge_from(other.m_teamsByScore, moved, emptyByScore);
+    m_numTeams += numTeams;
+    m_numTotalPlayers += other.m_numTotalPlayers;
+    //Leave the other world_cup empty
+    for (int i = 0; i < numTeams; i++) {
+        other.m_teamSlots.release(teams[i]->get_slot());
+    }
+    other.m_teamIndices.clear();
+    other.m_playerIndices.clear();
+    other.m_playerTable.clear();
+    other.m_matchHistory.clear();
+    other.m_numTeams = 0;
+    other.m_numTotalPlayers = 0;
+    delete[] teams;
+    return StatusType::SUCCESS;
+}
@@ -16,12 +16,21 @@
 #define WORLDCUP23A2_H_
 
 #include "wet2util.h"
-#include "Player.h"
 #include "Teams.h"
 #include "AVLTree.h"
 #include "GenericNode.h"
 #include "AVLMultiTree.h"
 #include "ComplexNode.h"
+#include "RangeTree.h"
+#include "FrozenSnapshot.h"
+#include "RankFenwick.h"
+#include "PlayerTable.h"
+#include "HashIndex.h"
+#include "SeasonSimulator.h"
+#include "TeamSlots.h"
+#include "MatchHistory.h"
+#include "Sorting.h"
+#include "SpiritBatch.h"
 #include <memory.h>
 
 class world_cup_t {
@@ -30,15 +39,39 @@ private:
     int m_numTotalPlayers;
     //Total number of teams in the world cup
     int m_numTeams;
-    //Current hash table size
-    int m_currentHashSize;
-    //Hash table of AVL trees of players
-    Tree<GenericNode<Player*>, Player*>** m_playersHashTable;
-    //Tree of shared pointers of the type team, with all the teams in the game sorted by their ID
-    Tree<GenericNode<Team*>, Team*> m_teamsByID;
+    //Hash table of the players' indices in m_playerTable, by the players' ID
+    HashIndex<int> m_playerIndices;
+    //All of the players (inactive or active) and their upside-down trees, by the index of the player
+    PlayerTable m_playerTable;
+    //Hash table of all the teams in the game, by their ID (for the searches of a single team)
+    HashIndex<Team*> m_teamIndices;
+    //The slots of the teams, for the operations that take a TeamHandle instead of a team ID
+    TeamSlots m_teamSlots;
+    //The log of all of the matches that were played, with the last matches of every team and the head-to-head records
+    MatchHistory m_matchHistory;
+    //Tree of shared pointers of the type team, with all the teams in the game sorted by their ID (for the operations
+    //that need the order of the IDs). Every subtree also counts its valid teams (teams with a goalkeeper), for the
+    //knockout brackets
+    RangeTree<Team*> m_teamsByID;
     //Tree of shared pointers of the type team, with all the teams in the game.
     //It is sorted by their overall players' ability + points, then the team's spiritual "power", and then the teams' ID
     MultiTree<Team*> m_teamsByAbility;
+    //Tree of the teams sorted by their score (points + overall players' ability), and then the teams' ID
+    MultiTree<Team*> m_teamsByScore;
+    //Offline replacement of m_teamsByAbility, used when all of the rank keys are known in advance (else nullptr)
+    RankFenwick* m_offlineRanks;
+    //Read-only snapshot for get_team_points, get_ith_pointless_ability and get_player_cards (nullptr when thawed)
+    FrozenSnapshot* m_frozen;
+    //The way in which the union-find of the players shortens paths
+    FindPolicy m_findPolicy;
+
+    /*
+    * REBUILD_RATIO - remove_teams rebuilds the trees of teams in a single pass (instead of removing the teams from them
+    *       one by one) when at least one in REBUILD_RATIO of the teams is removed
+    */
+    enum {
+        REBUILD_RATIO = 4
+    };
 
     //-------------------------------------------Helper Functions----------------------------------------------
 
@@ -49,35 +82,125 @@ private:
     bool check_player_exists(int playerId);
 
     /*
-    * Check if player exists in hash table (inactive or active)
-    * @return - true if player already exists, else return false
+    * Check if a player handle refers to a player of the world cup (inactive or active): the handle of every overload
+    *       that takes a PlayerHandle is checked here
+    * @return - true if the handle is valid, else return false (also for the handle of another world cup)
     */
-    bool check_player_kicked_out(int playerId);
+    bool is_player(const PlayerHandle& player) const;
 
     /*
-    * When the number of players = size of table, the table needs to be enlarged to ensure time complexity of O(1)
-    *   for inserting + searching for players
+    * Remove a team that was already found from all of the structures of the world cup, and delete it.
+    *       Its players stay, without a team, and its slot is released (so its handles become invalid).
     * @return - none
     */
-    void enlarge_hash_table();
+    void erase_team(Team* team);
+
+    /*
+    * The body of add_player, after the inputs were checked and the team was found
+    * @param - the player's ID, its team, its stats, and a reference that receives the handle of the new player
+    * @return - the same as add_player
+    */
+    StatusType insert_player(const int playerId, Team* team, const permutation_t& spirit, const int gamesPlayed,
+                             const int ability, const int cards, const bool goalKeeper, PlayerHandle& handle);
+
+    /*
+    * The body of play_match, after the two teams were found
+    * @return - the same as play_match
+    */
+    output_t<int> match_teams(Team* team1, Team* team2);
+
+    /*
+    * The body of buy_team, after the two teams were found (the bought team is erased without searching it again)
+    * @return - the same as buy_team
+    */
+    StatusType unite_teams(Team* buyer, Team* bought);
+
+    /*
+    * The body of export_team_players, after the team was found
+    * @return - the same as export_team_players
+    */
+    output_t<int> export_players(Team* team, int* playerIds, int* gamesPlayed, permutation_t* partialSpirits,
+                                 const int bufferSize);
 
     /*
-    * Deallocate memory of previous hash table
+    * Find the root of the player with the given index (which also shortens the path from the player to it), and
+    *       return the number of games the player played
+    * @return - the number of games
+    */
+    int player_games(const int index);
+
+    /*
+    * Find the root of the player with the given index (which also shortens the path from the player to it), and
+    *       return the player's partial spirit
+    * @return - the partial spirit, or FAILURE if the player's team was removed
+    */
+    output_t<permutation_t> player_partial_spirit(const int index);
+
+    /*
+    * The body of add_player_cards, after the player was found
+    * @return - the same as add_player_cards
+    */
+    StatusType give_player_cards(const int index, const int cards);
+
+    /*
+    * Call the visitor with the ID of every current player of a team that was already found
     * @return - none
     */
-    void destroy_old_hash_table(Tree<GenericNode<Player*>, Player*>** tmpTable);
+    template <class Visitor>
+    void visit_players(Team* team, Visitor& visitor);
 
     /*
-    * Insert new player to hash table
+    * Play a match between two valid teams: update their points and games (but not their place in the tree of teams
+    *       by score), and record it at its place in the match history (see MatchHistory::extend). It only changes the
+    *       two teams and the match's place, so matches without a shared team can be applied at the same time.
+    * @param - the teams (in the order of play_match), and the place of the match in the match history
+    * @return - the result of the match, the same as play_match
+    */
+    int apply_match(Team* team1, Team* team2, const int match);
+
+    /*
+    * Helper function for play_matches:
+    * Partition the matches that are played into rounds in which no team plays twice: every match is in the round
+    *       after the previous match of each of its teams, so a team plays its matches in their order
+    * @param - the local indices of the teams of every match (2i and 2i+1), the statuses of the matches (only the
+    *          successful ones are played), the number of matches and of local teams, arrays for the last round of
+    *          every team and the round of every match, and arrays that receive the start of every round (and the end
+    *          of the last one) and the matches sorted by their rounds (in their order inside every round)
+    * @return - the number of rounds
+    */
+    static int partition_rounds(const int* slotTeams, const StatusType* statuses, const int numMatches,
+                                const int numTeams, int* lastRounds, int* matchRounds, int* roundStarts, int* order);
+
+    /*
+    * Find the key of a team in the rank of teams by ability, before inserting it.
+    * In offline mode this is the position of the key in the offline ranks, otherwise it is always 1.
+    * @return - the key, or 0 if the offline ranks do not know the key
+    */
+    int rank_key(const int teamId, const int ability);
+
+    /*
+    * Insert a team to the rank of teams by ability (the rank tree, or the offline ranks if they are enabled)
     * @return - none
     */
-    void insert_player_hash_table(Player* tmpPlayer);
+    void rank_insert(Team* team, const int ability, const int rankKey);
 
     /*
-    * Calculate placement of player in hash table according to the hash function
-    * @return - integer that is equal to the player's index in the hash table
+    * Remove a team from the rank of teams by ability (the rank tree, or the offline ranks if they are enabled)
+    * @return - none
     */
-    int hash_function(int id);
+    void rank_remove(Team* team, const int ability);
+
+    /*
+    * Fix the location of a team in the tree of teams by score, after its score changed
+    * @return - none
+    */
+    void score_update(Team* team, const int prevScore);
+
+    /*
+    * Discard the read-only snapshot built by freeze(), if there is one. Called by every write.
+    * @return - none
+    */
+    void thaw();
 
 public:
 	// <DO-NOT-MODIFY> {
@@ -110,6 +233,284 @@ public:
 	StatusType buy_team(int teamId1, int teamId2);
 	
 	// } </DO-NOT-MODIFY>
+
+    /*
+    * Offline execution mode: replace the rank tree of teams by ability with a Fenwick tree over the given keys.
+    * Every (ability, team ID) key that the teams will reach must be given (see RankKeyScanner), and the mode
+    *       can only be enabled before the first team is added.
+    * @return - SUCCESS, or FAILURE if teams were already added or the mode is already enabled
+    */
+    StatusType enable_offline_ranks(const int* abilities, const int* teamIds, int numKeys);
+
+    /*
+    * Find the teams with all of the given indices (like get_ith_pointless_ability), in a single descent
+    * @param - the indices, sorted in non-decreasing order, their number, and an array that receives the team IDs
+    * @return - SUCCESS, INVALID_INPUT if the indices are not sorted, or FAILURE if an index is out of range
+    */
+    StatusType get_ith_pointless_abilities(const int* indices, int numIndices, int* teamIds);
+
+    /*
+    * Find the team with the given index, when the teams are sorted by their score (points + ability) and then ID
+    * @return - the ID of the team
+    */
+    output_t<int> get_ith_team_by_score(int i);
+
+    /*
+    * Find the index of a team, when the teams are sorted by their score (points + ability) and then ID
+    * @return - the index of the team
+    */
+    output_t<int> get_team_score_rank(int teamId);
+
+    /*
+    * Simulate a knockout bracket of the valid teams with an ID in [minTeamId, maxTeamId], without changing the
+    *       state of the league. Every round pairs adjacent teams by ID (an odd team out advances), and the winner
+    *       absorbs the loser's score plus the 3 points of the win. A match is won by the higher score, then the
+    *       higher spirit strength, and then the higher ID.
+    * @return - the ID of the winner, INVALID_INPUT if the range is invalid, or FAILURE if it has no valid teams
+    */
+    output_t<int> knockout_winner(int minTeamId, int maxTeamId);
+
+    /*
+    * Compile the current state into a read-only snapshot, which answers get_team_points,
+    *       get_ith_pointless_ability and get_player_cards until the next write (which thaws it)
+    * @return - SUCCESS, or ALLOCATION_ERROR
+    */
+    StatusType freeze();
+
+    /*
+    * Choose the way in which the union-find of the players shortens the path to the root (see FindPolicy).
+    *       The default is FULL_COMPRESSION.
+    * @return - none
+    */
+    void set_find_policy(FindPolicy policy);
+
+    /*
+    * Call the visitor with the ID of every current player of the team, in O(number of players in the team)
+    * @param - the team's ID, and a visitor that can be called as visitor(int playerId)
+    * @return - SUCCESS, INVALID_INPUT if the ID is invalid, or FAILURE if the team doesn't exist
+    */
+    template <class Visitor>
+    StatusType for_each_player(int teamId, Visitor&& visitor);
+
+    /*
+    * Export the games played and the partial spirit of every current player of the team (the same values as
+    *       num_played_games_for_player and get_partial_spirit), with a single search of the team and a single pass
+    *       over its players, into columnar buffers
+    * @param - the team's ID, buffers that receive the players' IDs, games and partial spirits, and their size
+    * @return - the number of players, INVALID_INPUT if the ID or the buffers are invalid, or FAILURE if the team
+    *           doesn't exist or the buffers are too small
+    */
+    output_t<int> export_team_players(int teamId, int* playerIds, int* gamesPlayed, permutation_t* partialSpirits,
+                                      int bufferSize);
+
+    /*
+    * Return the total number of cards the team's current players received, in O(1)
+    * @return - the total number of cards, INVALID_INPUT if the ID is invalid, or FAILURE if the team doesn't exist
+    */
+    output_t<int> get_team_cards(int teamId);
+
+    /*
+    * Return the sum of the number of games the team's current players played, in O(1)
+    * @return - the sum of the games, INVALID_INPUT if the ID is invalid, or FAILURE if the team doesn't exist
+    */
+    output_t<int> get_team_player_games(int teamId);
+
+    /*
+    * Return the counters of the union-find of the players (find lengths, compressions and union sizes), since the
+    *       world cup was created or since reset_union_find_stats
+    * @return - the counters
+    */
+    const UnionFindStats& get_union_find_stats() const;
+
+    /*
+    * Set the counters of the union-find of the players to 0
+    * @return - none
+    */
+    void reset_union_find_stats();
+
+    /*
+    * Play a match day: the matches have exactly the same results as calling play_match for every one of them, in
+    *       the given order. Every team ID is searched once, the matches are partitioned into rounds in which no team
+    *       plays twice (a team plays its matches in their order, in later and later rounds), and the tree of teams by
+    *       score is fixed once per team at the end of the day. The matches of a round are independent, so they run
+    *       in parallel when the code is compiled with OpenMP (-fopenmp), and one by one otherwise.
+    * @param - the IDs of the two teams of every match, the number of matches, and arrays that receive the result of
+    *          every match (-1 if it wasn't played) and its status
+    * @return - SUCCESS (even if some of the matches failed), INVALID_INPUT if the arrays are invalid,
+    *           or ALLOCATION_ERROR
+    */
+    StatusType play_matches(const int* teamIds1, const int* teamIds2, int numMatches, int* results,
+                            StatusType* statuses);
+
+    /*
+    * Simulate a round-robin season of the valid teams (every team plays every other once, see SeasonSimulator),
+    *       starting from their current points, without changing the state of the league
+    * @param - arrays that receive the team IDs and their final points, sorted by the points (highest first) and then
+    *          by ID, and their size
+    * @return - the number of teams, INVALID_INPUT if the arrays are invalid, or FAILURE if they are too small
+    */
+    output_t<int> simulate_season(int* teamIds, int* points, int bufferSize,
+                                  SeasonKernel kernel = SeasonKernel::BEST);
+
+    /*
+    * Buy several teams at once, with the same result as calling buy_team(buyerId, boughtIds[i]) for every one of them
+    *       in order: the players of all of the teams are united in one pass, and the buying team is moved in the
+    *       trees of teams by ability and by score once
+    * @param - the ID of the buying team, the IDs of the bought teams and their number
+    * @return - SUCCESS, INVALID_INPUT if an ID is invalid or equal to the buyer's, FAILURE if a team doesn't exist or
+    *           is bought twice (and then no team is bought), or ALLOCATION_ERROR
+    */
+    StatusType buy_teams(int buyerId, const int* boughtIds, int numBought);
+
+    /*
+    * Add a squad of players to a team at once, with the same result as calling add_player for every one of them in
+    *       order: the spirits of the players are multiplied once, all of them are attached to the team's root, and
+    *       the team is moved in the trees of teams by ability and by score once
+    * @param - the ID of the team, the details of the players and their number
+    * @return - SUCCESS, INVALID_INPUT if an input is invalid, FAILURE if the team doesn't exist or a player ID
+    *           already exists or repeats (and then no player is added), or ALLOCATION_ERROR
+    */
+    StatusType add_players(int teamId, const PlayerSpec* players, int numPlayers);
+
+    /*
+    * Remove several teams at once, with the same result as calling remove_team for every one of them: the players of
+    *       all of the teams are detached together, and when many of the teams go, the trees of teams are rebuilt
+    *       from the remaining teams in a single pass
+    * @param - the IDs of the removed teams and their number
+    * @return - SUCCESS, INVALID_INPUT if an ID is invalid, FAILURE if a team doesn't exist or is removed twice (and then
+    *           no team is removed), or ALLOCATION_ERROR
+    */
+    StatusType remove_teams(const int* teamIds, int numTeams);
+
+    /*
+    * Return the last matches of a team, from the newest to the oldest (only the team's own matches: the matches of
+    *       the teams it bought are not moved to it)
+    * @param - the ID of the team, the number of matches, and an array (of that number) that receives the matches
+    * @return - the number of matches written (fewer if the team played fewer matches), INVALID_INPUT if an input is
+    *           invalid, or FAILURE if the team doesn't exist
+    */
+    output_t<int> get_last_matches(int teamId, int numMatches, MatchRecord* matches);
+
+    /*
+    * Return the record of a team against another team, over the matches they played since both of them were added
+    * @param - the IDs of the two teams, and a reference that receives the number of matches the first team won, tied
+    *          and lost against the second team
+    * @return - SUCCESS, INVALID_INPUT if an ID is invalid or the IDs are equal, FAILURE if a team doesn't exist, or
+    *           ALLOCATION_ERROR
+    */
+    StatusType get_head_to_head(int teamId1, int teamId2, HeadToHead& record);
+
+    /*
+    * Move all of the teams, players and matches of another world_cup into this one, with the same result as replaying
+    *       its adds, matches and buys here: the players and the log of matches are appended after the ones of this
+    *       world_cup, and the trees of teams are merged in a single pass each, reusing the other world_cup's nodes.
+    *       The other world_cup is left empty, and can be used again. Its handles stop being valid, in both world_cups:
+    *       its team slots are released, and its table of players takes a new epoch before it reuses their indices.
+    * @param - the other world_cup
+    * @return - SUCCESS, INVALID_INPUT if the other world_cup is this one, FAILURE if a team or player ID (including a
+    *           player of a removed team) is in both of them, or if either of them runs with offline ranks (and then
+    *           nothing is moved), or ALLOCATION_ERROR
+    */
+    StatusType merge_from(world_cup_t&& other);
+
+    /*
+    * Handles: a TeamHandle or PlayerHandle refers to a team or player without its ID, so the overloads that take
+    *       handles do no search by ID. A team handle stops being valid once its team is removed (or bought), a handle
+    *       is never valid in another world_cup, and the overloads return FAILURE for an invalid handle. Otherwise every
+    *       overload returns the same as the overload that takes IDs.
+    */
+
+    /*
+    * Add a team, and return its handle
+    * @param - the team's ID, and a reference that receives the handle of the new team
+    * @return - the same as add_team
+    */
+    StatusType add_team(int teamId, TeamHandle& handle);
+
+    /*
+    * Add a player to the team of the handle, and return the player's handle
+    * @param - the player's ID, the team's handle, the player's stats, and a reference that receives its handle
+    * @return - the same as add_player
+    */
+    StatusType add_player(int playerId, TeamHandle team, const permutation_t& spirit, int gamesPlayed, int ability,
+                          int cards, bool goalKeeper, PlayerHandle& handle);
+
+    /*
+    * Return the handle of the team / player with the given ID (a player of a removed team also has a handle)
+    * @return - the handle, INVALID_INPUT if the ID is invalid, or FAILURE if it doesn't exist
+    */
+    output_t<TeamHandle> resolve_team(int teamId);
+    output_t<PlayerHandle> resolve_player(int playerId);
+
+    /*
+    * The operations on teams, by their handles
+    */
+    StatusType remove_team(TeamHandle team);
+    output_t<int> play_match(TeamHandle team1, TeamHandle team2);
+    output_t<int> get_team_points(TeamHandle team);
+    StatusType buy_team(TeamHandle team1, TeamHandle team2);
+    output_t<int> get_team_score_rank(TeamHandle team);
+    output_t<int> get_team_cards(TeamHandle team);
+    output_t<int> get_team_player_games(TeamHandle team);
+    output_t<int> export_team_players(TeamHandle team, int* playerIds, int* gamesPlayed, permutation_t* partialSpirits,
+                                      int bufferSize);
+    template <class Visitor>
+    StatusType for_each_player(TeamHandle team, Visitor&& visitor);
+
+    /*
+    * The operations on players, by their handles
+    */
+    output_t<int> num_played_games_for_player(PlayerHandle player);
+    StatusType add_player_cards(PlayerHandle player, int cards);
+    output_t<int> get_player_cards(PlayerHandle player);
+    output_t<permutation_t> get_partial_spirit(PlayerHandle player);
 };
 
+//-------------------------------------------Rosters----------------------------------------------
+
+template <class Visitor>
+StatusType world_cup_t::for_each_player(int teamId, Visitor&& visitor)
+{
+    if (teamId <= 0) {
+        return StatusType::INVALID_INPUT;
+    }
+    Team* team;
+    try {
+        team = m_teamIndices.search_and_return_data(teamId);
+    }
+    catch (const NodeNotFound& e) {
+        return StatusType::FAILURE;
+    }
+    visit_players(team, visitor);
+    return StatusType::SUCCESS;
+}
+
+
+template <class Visitor>
+StatusType world_cup_t::for_each_player(TeamHandle team, Visitor&& visitor)
+{
+    Team* found = m_teamSlots.get_team(team);
+    if (found == nullptr) {
+        return StatusType::FAILURE;
+    }
+    visit_players(found, visitor);
+    return StatusType::SUCCESS;
+}
+
+
+template <class Visitor>
+void world_cup_t::visit_players(Team* team, Visitor& visitor)
+{
+    int root = team->get_allPlayers();
+    if (root == PlayerTable::NO_PLAYER) {
+        return;
+    }
+    //Walk the circular list of the members of the team's upside-down tree, once around
+    int current = root;
+    do {
+        visitor(m_playerTable.get_playerId(current));
+        current = m_playerTable.get_next_member(current);
+    } while (current != root);
+}
+
 #endif // WORLDCUP23A1_H_